@@ -33,7 +33,8 @@
 #include "FermionCompiler.hpp"
 #include "RuntimeOptions.hpp"
 #include "ServiceRegistry.hpp"
-#include "FermionKernel.hpp"
+#include "ColumnarFermionKernel.hpp"
+#include "FermionTermReader.hpp"
 #include "MPIProvider.hpp"
 
 namespace xacc {
@@ -59,47 +60,41 @@ std::shared_ptr<IR> FermionCompiler::compile(const std::string& src,
 
 	// Here we expect we have a kernel, only one kernel
 
-	// First off, split the string into lines
-	std::vector<std::string> lines, fLineSpaces;
-	lines = xacc::split(src,'\n');
-	auto functionLine = lines[0];
-	fLineSpaces = xacc::split(functionLine, ' ');
-	auto fName = fLineSpaces[1];
-	xacc::trim(fName);
-	fName = fName.substr(0, fName.find_first_of("("));
-	auto firstCodeLine = lines.begin() + 1;
-	auto lastCodeLine = lines.end() - 1;
-	std::vector<std::string> fermionStrVec(firstCodeLine, lastCodeLine);
-
-	fermionKernel = std::make_shared<FermionKernel>("fName");
-	nQubits = 0;
-	for (auto termStr : fermionStrVec) {
-		xacc::trim(termStr);
-		if (!termStr.empty() && (std::string::npos != termStr.find_first_of("0123456789"))) {
-			std::vector<std::string> splitOnSpaces;
-			splitOnSpaces = xacc::split(termStr, ' ');
-
-			// We know first term is coefficient
-			// FIXME WHAT IF COMPLEX
-			auto coeff = std::stod(splitOnSpaces[0]);
-			std::vector<std::pair<int, int>> operators;
-			for (int i = 1; i < splitOnSpaces.size()-1; i+=2) {
-				auto siteIdx = std::stoi(splitOnSpaces[i]);
-				if (siteIdx > nQubits) {
-					nQubits = siteIdx;
-				}
-				operators.push_back(
-						{siteIdx, std::stoi(
-								splitOnSpaces[i + 1]) });
-			}
-
-			auto fermionInst = std::make_shared<FermionInstruction>(operators,
-					coeff);
-			fermionKernel->addInstruction(fermionInst);
-		}
+	// The terms are the lines between the function
+	// signature and the closing brace
+	auto bodyBegin = src.find('\n');
+	auto bodyEnd = src.rfind('}');
+	if (bodyBegin == std::string::npos || bodyEnd == std::string::npos
+			|| bodyEnd < bodyBegin) {
+		xacc::error("Invalid fermion kernel source.");
+	}
+
+	int nThreads = xacc::optionExists("fermion-parse-threads") ?
+			std::stoi(xacc::getOption("fermion-parse-threads")) : 0;
+	FermionTermReader reader(nThreads);
+	auto terms = reader.parseKernel(src.data() + bodyBegin + 1,
+			src.data() + bodyEnd);
+	nQubits = std::max(terms.maxSite(), 0) + 1;
+
+	// Append the terms of an FCIDUMP or binary integral file
+	if (xacc::optionExists("fermion-integrals")) {
+		int nOrbitals = 0;
+		std::vector<FermionTermArena> parts;
+		parts.push_back(reader.read(xacc::getOption("fermion-integrals"),
+				nOrbitals));
+		terms.append(parts);
+		nQubits = std::max(nQubits, 2 * nOrbitals);
+	}
+
+	FermionTermColumns columns;
+	columns.reserve(terms.nTerms(), terms.operators.size());
+	for (int t = 0; t < terms.nTerms(); t++) {
+		columns.addTerm(terms.operators.data() + terms.offsets[t],
+				terms.offsets[t + 1] - terms.offsets[t], terms.coefficients[t]);
 	}
+	fermionKernel = std::make_shared<ColumnarFermionKernel>("fName",
+			std::move(columns));
 
-	nQubits++;
 	xacc::setOption("n-qubits", std::to_string(nQubits));
 
 	// Create the FermionIR to pass to our transformation.
@@ -81,6 +81,22 @@ public:
 				"fermion-list-transformations",
 				"List all available fermion-to-spin transformations."},{
 				"no-fermion-transformation", "Skip JW/BK transformation step."},{
+				"fermion-transformation-threads",
+				"Number of threads used to map fermion terms to spin terms."},{
+				"fermion-transformation-mpi",
+				"Distribute the fermion to spin mapping across MPI ranks."},{
+				"fermion-no-simplify",
+				"Map fermion terms as given, without merging, normal ordering and hermitian folding."},{
+				"fermion-threshold",
+				"Drop merged fermion terms with smaller coefficient magnitude (default 1e-12)."},{
+				"fermion-weight-report",
+				"Print the Pauli weights and estimated CNOT count of the mapped Hamiltonian."},{
+				"uccsd-no-optimize",
+				"Emit the UCCSD ansatz without reordering commuting exponentials and cancelling gates."},{
+				"fermion-integrals",
+				"FCIDUMP or binary integral file whose terms are added to the kernel."},{
+				"fermion-parse-threads",
+				"Number of threads used to parse kernel terms and integral files."},{
 				"fermion-compiler-silent","Turn off print statements."}};
 		return desc;
 	}
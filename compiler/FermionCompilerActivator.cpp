@@ -30,6 +30,7 @@
  **********************************************************************************/
 #include "FermionCompiler.hpp"
 #include "QubitTapering.hpp"
+#include "HamiltonianTruncation.hpp"
 
 #include "cppmicroservices/BundleActivator.h"
 #include "cppmicroservices/BundleContext.h"
@@ -56,11 +57,14 @@ public:
 	void Start(BundleContext context) {
 		auto c = std::make_shared<xacc::vqe::FermionCompiler>();
         auto o = std::make_shared<xacc::vqe::QubitTapering>();
+        auto t = std::make_shared<xacc::vqe::HamiltonianTruncation>();
         
 		context.RegisterService<xacc::Compiler>(c);
 		context.RegisterService<xacc::OptionsProvider>(c);
         context.RegisterService<xacc::IRTransformation>(o);
 		context.RegisterService<xacc::OptionsProvider>(o);
+        context.RegisterService<xacc::IRTransformation>(t);
+		context.RegisterService<xacc::OptionsProvider>(t);
 	}
 
 	/**
@@ -0,0 +1,404 @@
+#include "FermionTermReader.hpp"
+#include "XACC.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace xacc {
+namespace vqe {
+
+namespace {
+
+const char binaryMagic[] = "FCIDUMPB";
+const std::size_t binaryHeaderSize = 8 + 2 * sizeof(std::int64_t);
+
+/**
+ * Upper case a character, the <cctype> functions are
+ * only defined for unsigned char values.
+ */
+char toUpper(const char c) {
+	return std::toupper(static_cast<unsigned char>(c));
+}
+
+/**
+ * Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+
+protected:
+	int fd = -1;
+	const char* ptr = nullptr;
+	std::size_t length = 0;
+
+public:
+
+	MappedFile(const std::string& fileName) {
+		fd = open(fileName.c_str(), O_RDONLY);
+		if (fd < 0) {
+			xacc::error("Could not open integral file " + fileName);
+			return;
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			xacc::error("Could not stat integral file " + fileName);
+			return;
+		}
+		length = st.st_size;
+		if (length > 0) {
+			auto p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p == MAP_FAILED) {
+				xacc::error("Could not map integral file " + fileName);
+				length = 0;
+				return;
+			}
+			ptr = static_cast<const char*>(p);
+			madvise(p, length, MADV_SEQUENTIAL);
+		}
+	}
+
+	const char* begin() const {
+		return ptr;
+	}
+
+	const char* end() const {
+		return ptr + length;
+	}
+
+	const std::size_t size() const {
+		return length;
+	}
+
+	~MappedFile() {
+		if (ptr) {
+			munmap(const_cast<char*>(ptr), length);
+		}
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+};
+
+/**
+ * Copy the line [begin, end) into buffer (reused across lines, so
+ * strtod never reads past the line or the end of a mapping).
+ * Fortran style exponents (1.0D-01) are converted to 1.0E-01.
+ */
+void copyLine(const char* begin, const char* end, std::string& buffer) {
+	buffer.assign(begin, end);
+	for (auto& c : buffer) {
+		if (c == 'D' || c == 'd') {
+			c = 'E';
+		}
+	}
+}
+
+const char* lineEnd(const char* p, const char* end) {
+	auto eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+	return eol ? eol : end;
+}
+
+/**
+ * Run f(t) for t in [0, n), on threads if n > 1.
+ */
+template<typename F>
+void parallelFor(const int n, F f) {
+	if (n == 1) {
+		f(0);
+		return;
+	}
+	std::vector<std::thread> threads;
+	for (int t = 0; t < n; t++) {
+		threads.push_back(std::thread(f, t));
+	}
+	for (auto& t : threads) {
+		t.join();
+	}
+}
+
+}
+
+void FermionTermArena::append(const std::vector<FermionTermArena>& parts) {
+	std::size_t nCoeffs = coefficients.size(), nOps = operators.size();
+	std::vector<std::size_t> coeffStart, opStart;
+	for (auto& p : parts) {
+		coeffStart.push_back(nCoeffs);
+		opStart.push_back(nOps);
+		nCoeffs += p.coefficients.size();
+		nOps += p.operators.size();
+	}
+	coefficients.resize(nCoeffs);
+	offsets.resize(nCoeffs + 1);
+	operators.resize(nOps);
+
+	parallelFor(parts.size(), [&](const int t) {
+		auto& p = parts[t];
+		std::copy(p.coefficients.begin(), p.coefficients.end(),
+				coefficients.begin() + coeffStart[t]);
+		std::copy(p.operators.begin(), p.operators.end(),
+				operators.begin() + opStart[t]);
+		for (int i = 1; i < p.offsets.size(); i++) {
+			offsets[coeffStart[t] + i] = opStart[t] + p.offsets[i];
+		}
+	});
+}
+
+FermionTermReader::FermionTermReader(const int threads) :
+		nThreads(threads) {
+	if (nThreads <= 0) {
+		nThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+}
+
+std::vector<const char*> FermionTermReader::lineChunks(const char* begin,
+		const char* end) {
+	// Not worth spawning threads for less than 64 kB
+	int n = std::max(1, std::min<int>(nThreads, (end - begin) / 65536));
+	std::vector<const char*> bounds {begin};
+	for (int t = 1; t < n; t++) {
+		auto p = std::max(bounds.back(), begin + t * (end - begin) / n);
+		p = lineEnd(p, end);
+		bounds.push_back(p < end ? p + 1 : end);
+	}
+	bounds.push_back(end);
+	return bounds;
+}
+
+FermionTermArena FermionTermReader::parseKernel(const char* begin,
+		const char* end) {
+	auto bounds = lineChunks(begin, end);
+	std::vector<FermionTermArena> parts(bounds.size() - 1);
+
+	parallelFor(parts.size(), [&](const int t) {
+		std::string line;
+		std::vector<std::pair<int, int>> ops;
+		for (auto p = bounds[t]; p < bounds[t + 1];) {
+			auto eol = lineEnd(p, bounds[t + 1]);
+			// Skip lines without terms, e.g. the closing brace
+			if (std::find_if(p, eol, [](const char ch) {
+				return std::isdigit(static_cast<unsigned char>(ch));
+			}) != eol) {
+				copyLine(p, eol, line);
+				char* c = &line[0];
+				auto coeff = std::strtod(c, &c);
+				ops.clear();
+				while (true) {
+					char* next;
+					auto site = std::strtol(c, &next, 10);
+					if (next == c) {
+						break;
+					}
+					c = next;
+					auto creation = std::strtol(c, &next, 10);
+					if (next == c) {
+						break;
+					}
+					c = next;
+					ops.push_back({(int) site, (int) creation});
+				}
+				parts[t].addTerm(coeff, ops.data(), ops.size());
+			}
+			p = eol + 1;
+		}
+	});
+
+	FermionTermArena arena;
+	arena.append(parts);
+	return arena;
+}
+
+std::vector<IntegralRecord> FermionTermReader::readFCIDUMPRecords(
+		const std::string& fileName, int& nOrbitals) {
+	MappedFile file(fileName);
+
+	// The namelist header ends with &END or /
+	std::string header;
+	auto p = file.begin();
+	for (; p < file.end();) {
+		auto eol = lineEnd(p, file.end());
+		std::string line(p, eol);
+		p = eol + 1;
+		header += line + " ";
+		std::transform(line.begin(), line.end(), line.begin(), toUpper);
+		auto slash = line.find('/');
+		if (line.find("&END") != std::string::npos
+				|| (slash != std::string::npos
+						&& line.find_first_not_of(" \t\r") == slash)) {
+			break;
+		}
+	}
+	std::transform(header.begin(), header.end(), header.begin(), toUpper);
+	auto norb = header.find("NORB");
+	if (norb == std::string::npos) {
+		xacc::error("Invalid FCIDUMP file " + fileName + ", no NORB in header.");
+	}
+	nOrbitals = std::stoi(header.substr(header.find('=', norb) + 1));
+
+	auto begin = std::min(p, file.end());
+	auto bounds = lineChunks(begin, file.end());
+	std::vector<std::vector<IntegralRecord>> parts(bounds.size() - 1);
+
+	parallelFor(parts.size(), [&](const int t) {
+		std::string line;
+		for (auto p = bounds[t]; p < bounds[t + 1];) {
+			auto eol = lineEnd(p, bounds[t + 1]);
+			copyLine(p, eol, line);
+			char* c = &line[0];
+			char* next;
+			IntegralRecord r;
+			r.value = std::strtod(c, &next);
+			if (next != c) {
+				c = next;
+				r.i = std::strtol(c, &c, 10);
+				r.j = std::strtol(c, &c, 10);
+				r.k = std::strtol(c, &c, 10);
+				r.l = std::strtol(c, &c, 10);
+				parts[t].push_back(r);
+			}
+			p = eol + 1;
+		}
+	});
+
+	std::size_t n = 0;
+	for (auto& part : parts) {
+		n += part.size();
+	}
+	std::vector<IntegralRecord> records;
+	records.reserve(n);
+	for (auto& part : parts) {
+		records.insert(records.end(), part.begin(), part.end());
+	}
+	return records;
+}
+
+void FermionTermReader::expand(const IntegralRecord* records,
+		const std::size_t n, FermionTermArena& arena) {
+	std::pair<int, int> ops[4];
+	for (std::size_t z = 0; z < n; z++) {
+		auto& r = records[z];
+		if (r.i == 0 && r.j == 0 && r.k == 0 && r.l == 0) {
+			arena.addTerm(r.value, ops, 0);
+		} else if (r.j == 0) {
+			// Orbital energies, not part of the Hamiltonian
+			continue;
+		} else if (r.k == 0 && r.l == 0) {
+			int p = r.i - 1, q = r.j - 1;
+			for (int sigma = 0; sigma < 2; sigma++) {
+				ops[0] = {2 * p + sigma, 1};
+				ops[1] = {2 * q + sigma, 0};
+				arena.addTerm(r.value, ops, 2);
+				if (p != q) {
+					ops[0] = {2 * q + sigma, 1};
+					ops[1] = {2 * p + sigma, 0};
+					arena.addTerm(r.value, ops, 2);
+				}
+			}
+		} else {
+			// The distinct index orders of (ij|kl) under the
+			// 8-fold permutational symmetry of real orbitals
+			int i = r.i - 1, j = r.j - 1, k = r.k - 1, l = r.l - 1;
+			int perms[8][4] = { {i, j, k, l}, {j, i, k, l}, {i, j, l, k},
+					{j, i, l, k}, {k, l, i, j}, {l, k, i, j}, {k, l, j, i},
+					{l, k, j, i} };
+			for (int x = 0; x < 8; x++) {
+				auto v = perms[x];
+				bool seen = false;
+				for (int y = 0; y < x && !seen; y++) {
+					seen = std::equal(v, v + 4, perms[y]);
+				}
+				if (seen) {
+					continue;
+				}
+				for (int sigma = 0; sigma < 2; sigma++) {
+					for (int tau = 0; tau < 2; tau++) {
+						// (ab|cd) a^dag_{a sigma} a^dag_{c tau} a_{d tau} a_{b sigma}
+						int P = 2 * v[0] + sigma, S = 2 * v[1] + sigma;
+						int Q = 2 * v[2] + tau, R = 2 * v[3] + tau;
+						if (P == Q || R == S) {
+							continue;
+						}
+						ops[0] = {P, 1};
+						ops[1] = {Q, 1};
+						ops[2] = {R, 0};
+						ops[3] = {S, 0};
+						arena.addTerm(0.5 * r.value, ops, 4);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FermionTermReader::expandAll(const IntegralRecord* records,
+		const std::size_t n, FermionTermArena& arena) {
+	int nParts = std::max<int>(1, std::min<int>(nThreads, n / 1024));
+	std::vector<FermionTermArena> parts(nParts);
+	parallelFor(nParts, [&](const int t) {
+		auto start = t * n / nParts, end = (t + 1) * n / nParts;
+		expand(records + start, end - start, parts[t]);
+	});
+	arena.append(parts);
+}
+
+FermionTermArena FermionTermReader::readFCIDUMP(const std::string& fileName,
+		int& nOrbitals) {
+	auto records = readFCIDUMPRecords(fileName, nOrbitals);
+	FermionTermArena arena;
+	expandAll(records.data(), records.size(), arena);
+	return arena;
+}
+
+FermionTermArena FermionTermReader::readBinary(const std::string& fileName,
+		int& nOrbitals) {
+	MappedFile file(fileName);
+	if (file.size() < binaryHeaderSize
+			|| std::strncmp(file.begin(), binaryMagic, 8) != 0) {
+		xacc::error("Invalid binary integral file " + fileName);
+	}
+
+	std::int64_t header[2];
+	std::memcpy(header, file.begin() + 8, sizeof(header));
+	nOrbitals = header[0];
+	auto n = static_cast<std::size_t>(header[1]);
+	if (file.size() < binaryHeaderSize + n * sizeof(IntegralRecord)) {
+		xacc::error("Truncated binary integral file " + fileName);
+	}
+
+	// The mapping is page aligned and the header is 24 bytes,
+	// so the records can be used in place
+	auto records = reinterpret_cast<const IntegralRecord*>(file.begin()
+			+ binaryHeaderSize);
+	FermionTermArena arena;
+	expandAll(records, n, arena);
+	return arena;
+}
+
+FermionTermArena FermionTermReader::read(const std::string& fileName,
+		int& nOrbitals) {
+	char magic[8] = { };
+	std::ifstream in(fileName, std::ios::binary);
+	in.read(magic, 8);
+	if (std::strncmp(magic, binaryMagic, 8) == 0) {
+		return readBinary(fileName, nOrbitals);
+	}
+	return readFCIDUMP(fileName, nOrbitals);
+}
+
+void FermionTermReader::writeBinary(const std::string& fileName,
+		const int nOrbitals, const std::vector<IntegralRecord>& records) {
+	std::ofstream out(fileName, std::ios::binary);
+	std::int64_t header[2] = { nOrbitals, (std::int64_t) records.size() };
+	out.write(binaryMagic, 8);
+	out.write(reinterpret_cast<const char*>(header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(records.data()),
+			records.size() * sizeof(IntegralRecord));
+}
+
+}
+}
@@ -0,0 +1,142 @@
+#ifndef COMPILER_FERMIONTERMREADER_HPP_
+#define COMPILER_FERMIONTERMREADER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * The FermionTermArena stores a list of fermion terms in three flat
+ * arrays. Term t has coefficient coefficients[t] and the
+ * (site, creation) operators operators[offsets[t]] ...
+ * operators[offsets[t+1]-1].
+ */
+struct FermionTermArena {
+
+	std::vector<double> coefficients;
+	std::vector<int> offsets {0};
+	std::vector<std::pair<int, int>> operators;
+
+	const int nTerms() const {
+		return coefficients.size();
+	}
+
+	void addTerm(const double coeff, const std::pair<int, int>* ops,
+			const int nOps) {
+		coefficients.push_back(coeff);
+		operators.insert(operators.end(), ops, ops + nOps);
+		offsets.push_back(operators.size());
+	}
+
+	/**
+	 * Return the largest site index, or -1 if there are no operators.
+	 */
+	const int maxSite() const {
+		int max = -1;
+		for (auto& op : operators) {
+			max = op.first > max ? op.first : max;
+		}
+		return max;
+	}
+
+	/**
+	 * Append all the given arenas, allocating the storage once.
+	 */
+	void append(const std::vector<FermionTermArena>& parts);
+};
+
+/**
+ * One entry of an FCIDUMP file: the value of the chemist notation
+ * integral (ij|kl) over 1-based spatial orbitals. k = l = 0 denotes
+ * the one-body integral h_ij and i = j = k = l = 0 the core energy.
+ */
+struct IntegralRecord {
+	double value;
+	std::int32_t i, j, k, l;
+};
+
+/**
+ * The FermionTermReader reads fermion Hamiltonians without building
+ * per line strings. Inputs are split into line aligned chunks that
+ * are parsed concurrently into per thread arenas, which are then
+ * concatenated into one preallocated arena.
+ *
+ * Three inputs are supported:
+ *
+ *  - The body of a fermion kernel, one term per line as
+ *    coeff site creation site creation ...
+ *  - FCIDUMP files (memory mapped), with the integrals of the 8-fold
+ *    symmetric Hamiltonian over spatial orbitals.
+ *  - Binary integral files (memory mapped), an 8 byte magic "FCIDUMPB",
+ *    the int64 number of orbitals and number of records, followed by
+ *    the IntegralRecords in native byte order.
+ *
+ * Integral files are expanded into spin orbital terms with spin orbital
+ * 2p + sigma for spatial orbital p and spin sigma, and two-body terms
+ * (ps|qr)/2 a^dag_p a^dag_q a_r a_s.
+ */
+class FermionTermReader {
+
+protected:
+
+	int nThreads;
+
+	/**
+	 * Split [begin, end) into at most nThreads ranges that start
+	 * at the beginning of a line.
+	 */
+	std::vector<const char*> lineChunks(const char* begin, const char* end);
+
+	void expand(const IntegralRecord* records, const std::size_t n,
+			FermionTermArena& arena);
+
+	void expandAll(const IntegralRecord* records, const std::size_t n,
+			FermionTermArena& arena);
+
+public:
+
+	/**
+	 * The constructor, nThreads <= 0 uses all hardware threads.
+	 */
+	FermionTermReader(const int threads = 0);
+
+	/**
+	 * Parse the terms of a fermion kernel body.
+	 */
+	FermionTermArena parseKernel(const char* begin, const char* end);
+
+	/**
+	 * Read an FCIDUMP or binary integral file (detected by the
+	 * magic) and expand it into spin orbital terms.
+	 *
+	 * @param fileName The integral file
+	 * @param nOrbitals Set to the number of spatial orbitals
+	 * @return arena The fermion terms
+	 */
+	FermionTermArena read(const std::string& fileName, int& nOrbitals);
+
+	FermionTermArena readFCIDUMP(const std::string& fileName, int& nOrbitals);
+
+	FermionTermArena readBinary(const std::string& fileName, int& nOrbitals);
+
+	/**
+	 * Parse the integrals of an FCIDUMP file.
+	 */
+	std::vector<IntegralRecord> readFCIDUMPRecords(const std::string& fileName,
+			int& nOrbitals);
+
+	/**
+	 * Write integrals in the binary format read by readBinary.
+	 */
+	static void writeBinary(const std::string& fileName, const int nOrbitals,
+			const std::vector<IntegralRecord>& records);
+};
+
+}
+}
+
+#endif
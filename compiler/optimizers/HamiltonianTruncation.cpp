@@ -0,0 +1,97 @@
+#include "HamiltonianTruncation.hpp"
+#include "XACC.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace xacc {
+namespace vqe {
+
+PauliOperator HamiltonianTruncation::truncate(PauliOperator &H,
+                                              const double threshold,
+                                              const double budget,
+                                              double &bound) {
+  bound = 0.0;
+
+  // Keep whole terms, so variable coefficients survive
+  PauliOperator truncated;
+  auto keep = [&](Term &t) {
+    truncated += PauliOperator(t.ops(), t.coeff(), std::get<1>(t));
+  };
+
+  // Sort the non-identity terms by coefficient magnitude, the
+  // identity is never measured so there is no point dropping it.
+  // Terms with a variable have no known magnitude and are kept.
+  std::vector<std::pair<double, Term *>> terms;
+  for (auto &kv : H) {
+    if (kv.second.ops().empty() || !std::get<1>(kv.second).empty()) {
+      keep(kv.second);
+    } else {
+      terms.push_back({std::abs(kv.second.coeff()), &kv.second});
+    }
+  }
+  std::sort(terms.begin(), terms.end(),
+            [](const std::pair<double, Term *> &a,
+               const std::pair<double, Term *> &b) {
+              return a.first < b.first;
+            });
+
+  int i = 0;
+  for (; i < terms.size(); i++) {
+    if (terms[i].first >= threshold && bound + terms[i].first > budget) {
+      break;
+    }
+    bound += terms[i].first;
+  }
+
+  for (; i < terms.size(); i++) {
+    keep(*terms[i].second);
+  }
+
+  return truncated;
+}
+
+std::shared_ptr<IR> HamiltonianTruncation::transform(std::shared_ptr<IR> ir) {
+
+  double threshold = 0.0, budget = 1.6e-3;
+  if (xacc::optionExists("truncation-threshold")) {
+    threshold = std::stod(xacc::getOption("truncation-threshold"));
+  }
+  if (xacc::optionExists("truncation-error-budget")) {
+    budget = std::stod(xacc::getOption("truncation-error-budget"));
+  }
+  if (threshold < 0.0 || budget < 0.0) {
+    xacc::error("HamiltonianTruncation: threshold and error budget must be "
+                "non-negative.");
+  }
+
+  PauliOperator H;
+  H.fromXACCIR(ir);
+  auto nTerms = H.nTerms();
+
+  auto truncated = truncate(H, threshold, budget, errorBound);
+
+  std::stringstream s;
+  s << std::setprecision(6) << errorBound;
+  xacc::info("Hamiltonian truncation kept " +
+             std::to_string(truncated.nTerms()) + " of " +
+             std::to_string(nTerms) +
+             " terms, energy error bound = " + s.str());
+
+  auto newIR = truncated.toXACCIR();
+
+  // See if we have an ansatz and if so grab
+  // it and add it to the truncated IR
+  auto ansatz = std::dynamic_pointer_cast<Function>(
+      ir->getKernels()[0]->getInstruction(0));
+  if (ansatz) {
+    for (auto &k : newIR->getKernels()) {
+      k->insertInstruction(0, ansatz);
+    }
+  }
+
+  return newIR;
+}
+
+} // namespace vqe
+} // namespace xacc
@@ -0,0 +1,67 @@
+#ifndef COMPILER_HAMILTONIAN_TRUNCATION_HPP_
+#define COMPILER_HAMILTONIAN_TRUNCATION_HPP_
+
+#include "IRTransformation.hpp"
+#include "PauliOperator.hpp"
+#include "OptionsProvider.hpp"
+
+using namespace xacc::quantum;
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * HamiltonianTruncation is an IRTransformation that removes
+ * terms with small coefficients from a Pauli Hamiltonian, so that
+ * they are not measured as separate kernels.
+ *
+ * Terms are dropped if their coefficient magnitude is below
+ * truncation-threshold, and then, smallest first, as long as the sum of
+ * the dropped magnitudes stays within truncation-error-budget (by
+ * default chemical accuracy, 1.6e-3 Hartree). Since every Pauli string
+ * has operator norm 1, that sum bounds the change of every eigenvalue
+ * of the Hamiltonian, and so the error of the energy. Terms whose
+ * coefficient carries a variable are never dropped.
+ */
+class HamiltonianTruncation : public IRTransformation, public OptionsProvider {
+
+public:
+  HamiltonianTruncation() {}
+
+  virtual std::shared_ptr<IR> transform(std::shared_ptr<IR> ir);
+
+  /**
+   * Return the truncated Hamiltonian and set errorBound to the sum
+   * of the dropped coefficient magnitudes.
+   */
+  PauliOperator truncate(PauliOperator &H, const double threshold,
+                         const double budget, double &errorBound);
+
+  /**
+   * Return the energy error bound of the last transform.
+   */
+  const double getErrorBound() const { return errorBound; }
+
+  virtual const std::string name() const { return "hamiltonian-truncation"; }
+  virtual const std::string description() const {
+    return "Remove small Hamiltonian terms within an energy error budget.";
+  }
+
+  virtual OptionPairs getOptions() {
+    OptionPairs desc{
+        {"truncation-threshold",
+         "Drop terms with coefficient magnitude below this value (default 0)."},
+        {"truncation-error-budget",
+         "Drop the smallest terms while the sum of their coefficient "
+         "magnitudes stays within this value (default 1.6e-3, chemical "
+         "accuracy)."}};
+    return desc;
+  }
+
+private:
+  double errorBound = 0.0;
+};
+} // namespace vqe
+} // namespace xacc
+
+#endif
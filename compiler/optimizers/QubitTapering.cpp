@@ -1,302 +1,257 @@
 #include "QubitTapering.hpp"
 #include "PauliOperator.hpp"
-#include "MPIProvider.hpp"
-#include "DiagonalizeTask.hpp"
+#include "XACC.hpp"
 
+#include "LanczosSolver.hpp"
+#include "PauliSumMatVec.hpp"
+#include <Eigen/Dense>
 #include <algorithm>
 #include <iomanip>
 
 namespace xacc {
 namespace vqe {
 
-Eigen::MatrixXi QubitTapering::computeTableaux(PauliOperator &H, const int n) {
-  int nRows = 0;
-  Eigen::MatrixXi tableaux;
-  for (auto &term : H) {
-    Eigen::VectorXi x(n), z(n), row(2 * n);
-    auto p = term.second.toBinaryVector(n);
-    int c = 0;
-    for (auto &i : p.first) {
-      z(c) = i;
-      c++;
-    }
-    c = 0;
-    for (auto &i : p.second) {
-      x(c) = i;
-      c++;
-    }
+namespace {
 
-    row << x, z;
-    if (row != Eigen::VectorXi::Zero(2 * n)) {
-      nRows++;
-      tableaux.conservativeResize(nRows, 2 * n);
-      tableaux.row(nRows - 1) = row;
-    }
-  }
-  return tableaux;
+const bool bit(const std::uint64_t *words, const int q) {
+  return (words[q / 64] >> (q % 64)) & 1;
 }
 
-std::vector<std::vector<int>> QubitTapering::generateCombinations(
-    const int n, std::function<void(std::vector<int> &)> &&f) {
-  std::vector<std::vector<int>> combinations;
-
-  for (int nOnes = 0; nOnes <= n; nOnes++) {
-    std::vector<int> test(n);
-
-    for (int k = 0; k < nOnes; k++)
-      test[n - k - 1] = 1;
-
-    do {
-
-      // Perform custom mapping on the vector before adding
-      // By default this does nothing
-      f(test);
-      combinations.push_back(test);
-    } while (std::next_permutation(test.begin(), test.end()));
+const int parity(const std::uint64_t *a, const std::uint64_t *b) {
+  int p = 0;
+  for (int w = 0; w < BinaryPauliTerm::NWORDS; w++) {
+    p ^= __builtin_popcountll(a[w] & b[w]);
   }
-
-  return combinations;
+  return p & 1;
 }
 
-int QubitTapering::binaryVectorInnerProduct(std::vector<int> &bv1,
-                                            std::vector<int> &bv2) {
-  std::vector<int> ax(bv1.begin(), bv1.begin() + bv1.size() / 2);
-  std::vector<int> az(bv1.begin() + bv1.size() / 2, bv1.begin() + bv1.size());
-  std::vector<int> bx(bv2.begin(), bv2.begin() + bv2.size() / 2);
-  std::vector<int> bz(bv2.begin() + bv2.size() / 2, bv2.begin() + bv2.size());
-  Eigen::VectorXi axv = Eigen::Map<Eigen::VectorXi>(ax.data(), ax.size());
-  Eigen::VectorXi azv = Eigen::Map<Eigen::VectorXi>(az.data(), az.size());
-  Eigen::VectorXi bxv = Eigen::Map<Eigen::VectorXi>(bx.data(), bx.size());
-  Eigen::VectorXi bzv = Eigen::Map<Eigen::VectorXi>(bz.data(), bz.size());
-  return (axv.dot(bzv) + azv.dot(bxv)) % 2;
-}
-
-std::shared_ptr<IR> QubitTapering::transform(std::shared_ptr<IR> ir) {
-
-  // Convert the IR into a Hamiltonian
-  PauliOperator H;
-  H.fromXACCIR(ir);
-  auto n = H.nQubits();
-  int counter = 0;
-
-  // Compute Tableaux of the hamiltonian,
-  // This is the E matrix from arxiv:1701.08213
-  Eigen::MatrixXi tableaux = computeTableaux(H, n);
-  std::vector<int> pivotCols;
-
-  // Convert tableaux to rref
-  Eigen::MatrixXi b = gauss(tableaux, pivotCols);
-
-  // Get linear independent vectors from rref
-  int ker_dim = 2 * n - pivotCols.size();
-  Eigen::MatrixXi linIndVecs(pivotCols.size(), 2 * n);
-  linIndVecs.setZero();
-  std::vector<std::vector<int>> linIndVecsVector;
-  for (int i = 0; i < pivotCols.size(); i++) {
-    linIndVecs.row(i) = b.row(i);
-  }
-
-  // Build up the symmetry group generators
-  std::vector<int> zero(2 * n);
-  std::set<std::vector<int>> generators, generated;
-  generated.insert(zero);
-
-  // Get all g_z (combinations of nqubit 1s and 0s)
-  auto combinations = generateCombinations(n);
-
-  // Lambda to compute the union of 2 sets
-  auto getUnion = [](const std::set<std::vector<int>> &a,
-                     const std::set<std::vector<int>> &b) {
-    std::set<std::vector<int>> result = a;
-    result.insert(b.begin(), b.end());
-    return result;
-  };
-
-  // Loop over the g_z 0s and 1s combinations
-  for (auto &gz : combinations) {
-    std::vector<int> tau(n);
-    tau.insert(tau.end(), gz.begin(), gz.end());
-
-    if (generated.find(tau) != generated.end()) {
-      continue;
-    } else {
-
-      int sum = 0;
-      for (int i = 0; i < linIndVecs.rows(); i++) {
-        Eigen::VectorXi row = linIndVecs.row(i);
-        std::vector<int> h(2 * n);
-        Eigen::VectorXi::Map(&h[0], 2 * n) = row;
-        sum += binaryVectorInnerProduct(tau, h);
-      }
-
-      if (sum == 0) {
-        generators.insert(tau);
-        counter++;
-
-        if (counter == ker_dim)
-          break;
-
-        for (auto &g : generators) {
-          std::vector<int> s(2 * n);
-          for (int i = 0; i < 2 * n; i++) {
-            s[i] = (tau[i] + g[i]) % 2;
-          }
-
-          std::set<std::vector<int>> unionSet = getUnion(generators, generated);
-          if (unionSet.find(s) == unionSet.end()) {
-            generated.insert(s);
-          }
+const std::complex<double> iPowers[4] = {
+    {1.0, 0.0}, {0.0, 1.0}, {-1.0, 0.0}, {0.0, -1.0}};
+
+} // namespace
+
+void QubitTapering::findSymmetries(const BinaryPauliOperator &H, const int n,
+                                   std::vector<BinaryPauliTerm> &taus,
+                                   std::vector<int> &sites) {
+
+  // Insert the X part of every term into a GF(2) basis,
+  // keyed on the lowest set bit of each basis row
+  std::vector<BinaryPauliTerm> basis;
+  std::vector<int> pivots;
+  for (auto &kv : H.getTerms()) {
+    BinaryPauliTerm row;
+    std::copy(kv.first.first.x, kv.first.first.x + BinaryPauliTerm::NWORDS,
+              row.x);
+    for (int b = 0; b < basis.size(); b++) {
+      if (bit(row.x, pivots[b])) {
+        for (int w = 0; w < BinaryPauliTerm::NWORDS; w++) {
+          row.x[w] ^= basis[b].x[w];
         }
       }
     }
+    if (!row.isIdentity()) {
+      int w = 0;
+      while (!row.x[w]) {
+        w++;
+      }
+      basis.push_back(row);
+      pivots.push_back(64 * w + __builtin_ctzll(row.x[w]));
+    }
   }
 
-  // Create the tau generators
-  std::vector<PauliOperator> taus;
-  for (auto &g : generators) {
-    std::map<int, std::string> terms;
-    for (int i = 0; i < 2 * n; i++) {
-      if (g[i] == 1) {
-        if (i < n) {
-          terms.insert({i, "X"});
-        } else {
-          terms.insert({i - n, "Z"});
+  // Make the basis reduced, so each pivot is only set in its row
+  for (int b = 0; b < basis.size(); b++) {
+    for (int c = 0; c < basis.size(); c++) {
+      if (c != b && bit(basis[c].x, pivots[b])) {
+        for (int w = 0; w < BinaryPauliTerm::NWORDS; w++) {
+          basis[c].x[w] ^= basis[b].x[w];
         }
       }
     }
-    taus.emplace_back(terms);
   }
 
-//   for (auto t : taus) std::cout << "GEN: " << t.toString() << "\n";
-
-  // Lambda to compute hermitian conjugate of PauliOperator
-  auto hc = [](PauliOperator &op) {
-    PauliOperator newOp = op;
-    for (auto &kv : newOp) {
-      kv.second.coeff() = std::conj(kv.second.coeff());
+  // Each free column f gives a null space vector with a 1 at f,
+  // and at the pivots of the rows that have column f set
+  std::vector<bool> isPivot(n, false);
+  for (auto p : pivots) {
+    isPivot[p] = true;
+  }
+  for (int f = 0; f < n; f++) {
+    if (isPivot[f]) {
+      continue;
     }
-    return newOp;
-  };
-
-  // Compute U = U1 U2 U3 ...
-  double invSqrt2 = 1.0 / std::sqrt(2.0);
-  PauliOperator U(1.0);
-  for (auto &t : taus) {
-    int i = t.getTerms().begin()->second.ops().begin()->first;
-    U *= (t + PauliOperator({{i, "X"}})) * invSqrt2;
-    U *= (PauliOperator({{i, "X"}}) + PauliOperator({{i, "Z"}})) *
-         (1.0 / std::sqrt(2));
+    BinaryPauliTerm tau;
+    tau.set(f, 'Z');
+    for (int b = 0; b < basis.size(); b++) {
+      if (bit(basis[b].x, f)) {
+        tau.set(pivots[b], 'Z');
+      }
+    }
+    taus.push_back(tau);
+    sites.push_back(f);
   }
+}
 
-  // Use U to compute HPrime
-  PauliOperator HPrime = hc(U) * H * U;
-
-  // Compute rref of HPrime
-  Eigen::MatrixXi hPrimeTableaux = computeTableaux(HPrime, n);
-  std::vector<int> hPrimePivotCols;
-  Eigen::MatrixXi b2 = gauss(hPrimeTableaux, hPrimePivotCols);
+void QubitTapering::conjugate(BinaryPauliTerm &t, std::complex<double> &c,
+                              const BinaryPauliTerm &tau, const int q) {
+
+  // (tau + X) P (tau + X) / 2 is P if P commutes with tau and X,
+  // -P if it anticommutes with both, P tau X if it only anticommutes
+  // with X and -P tau X if it only anticommutes with tau
+  bool antiTau = parity(t.x, tau.z), antiX = bit(t.z, q);
+  if (antiTau && antiX) {
+    c = -c;
+  } else if (antiTau || antiX) {
+    BinaryPauliTerm x, tmp;
+    x.set(q, 'X');
+    auto k = t.multiply(tau, tmp);
+    k += tmp.multiply(x, t);
+    c *= iPowers[k % 4];
+    if (antiTau) {
+      c = -c;
+    }
+  }
 
-  // Convert to hPrimePivotCols vector to a set
-  std::set<int> hPrimePivotColsSet(hPrimePivotCols.begin(),
-                                   hPrimePivotCols.end()),
-      doubleNSet, nSet;
+  // Hadamard on q, swapping X and Z and mapping Y to -Y
+  auto w = q / 64;
+  auto mask = std::uint64_t(1) << (q % 64);
+  bool hasX = t.x[w] & mask, hasZ = t.z[w] & mask;
+  if (hasX != hasZ) {
+    t.x[w] ^= mask;
+    t.z[w] ^= mask;
+  } else if (hasX) {
+    c = -c;
+  }
+}
 
-  // Generate range(2*n)
-  for (int i = 0; i < 2 * n; i++)
-    doubleNSet.insert(i);
+BinaryPauliOperator QubitTapering::reduce(const BinaryPauliOperator &HPrime,
+                                          const int n,
+                                          const std::vector<int> &sites,
+                                          const std::vector<int> &sector) {
+  std::vector<int> newSite(n, -1);
+  for (int q = 0, counter = 0; q < n; q++) {
+    if (std::find(sites.begin(), sites.end(), q) == sites.end()) {
+      newSite[q] = counter++;
+    }
+  }
 
-  // Generate range(n)
-  for (int i = 0; i < n; i++)
-    nSet.insert(i);
+  BinaryPauliOperator reduced;
+  for (auto &kv : HPrime.getTerms()) {
+    auto &t = kv.first.first;
+    auto c = kv.second;
+    for (int i = 0; i < sites.size(); i++) {
+      if (bit(t.z, sites[i])) {
+        c *= sector[i];
+      }
+    }
+    BinaryPauliTerm r;
+    for (int q = 0; q < n; q++) {
+      if (newSite[q] >= 0 && (bit(t.x, q) || bit(t.z, q))) {
+        r.set(newSite[q], t.get(q));
+      }
+    }
+    reduced.addTerm(r, c, kv.first.second);
+  }
+  reduced.simplify();
+  return reduced;
+}
 
-  // Create the phase_sites set which is the difference between
-  // range(2*nQ) and the hPrimePivotSet
-  std::set<int> phase_sites, keep_sites;
-  std::set_difference(doubleNSet.begin(), doubleNSet.end(),
-                      hPrimePivotColsSet.begin(), hPrimePivotColsSet.end(),
-                      std::inserter(phase_sites, phase_sites.end()));
+std::shared_ptr<IR> QubitTapering::transform(std::shared_ptr<IR> ir) {
 
-  // Create the keep_sites set, i.e. the qubit sites we
-  // are keeping in the reduction
-  std::set_difference(nSet.begin(), nSet.end(), phase_sites.begin(),
-                      phase_sites.end(),
-                      std::inserter(keep_sites, keep_sites.end()));
+  // Convert the IR into a Hamiltonian
+  PauliOperator op;
+  op.fromXACCIR(ir);
+  auto n = op.nQubits();
+  BinaryPauliOperator H(op);
+
+  std::vector<BinaryPauliTerm> taus;
+  std::vector<int> sites;
+  findSymmetries(H, n, taus, sites);
+
+  // Transform H so that every tau_i becomes Z on its site
+  BinaryPauliOperator HPrime;
+  for (auto &kv : H.getTerms()) {
+    auto t = kv.first.first;
+    auto c = kv.second;
+    for (int i = 0; i < taus.size(); i++) {
+      conjugate(t, c, taus[i], sites[i]);
+    }
+    HPrime.addTerm(t, c, kv.first.second);
+  }
 
-  // Generate all 1s and 0s of list size phase_sites.size(), map
-  // all 0s to -1s.
-  std::vector<std::vector<int>> phase_configs =
-      generateCombinations(phase_sites.size(), [&](std::vector<int> &tmp) {
-        for (int i = 0; i < phase_sites.size(); i++) {
-          if (tmp[i] == 0)
-            tmp[i] = -1;
-        }
-        return;
-      });
+  std::stringstream ss;
+  for (int i = 0; i < taus.size(); i++) {
+    ss << (i ? ", " : "") << taus[i].toOps().size() << "-qubit Z on "
+       << sites[i];
+  }
+  xacc::info("Found " + std::to_string(taus.size()) +
+             " Z2 symmetries: " + ss.str());
 
-  // Create the reduced hamiltonian
-  // by mapping operators on unused qubits to
-  // +-1 subspace
-  PauliOperator actualReduced;
+  // Choose the sector, the eigenvalues of the tau_i
+  std::vector<int> sector(taus.size(), 1);
+  BinaryPauliOperator actualReduced;
   double energy = 0.0;
-  for (auto &phases : phase_configs) {
-    counter = 0;
-    std::map<int, int> Z2_dict;
-    for (auto &z : phase_sites) {
-      Z2_dict.insert({z, phases[counter]});
-      counter++;
+  bool haveEnergy = false;
+  if (xacc::optionExists("phase-sector")) {
+    auto phases = xacc::getOption("phase-sector");
+    std::replace(phases.begin(), phases.end(), ',', ' ');
+    std::stringstream ps(phases);
+    sector.clear();
+    int phase;
+    while (ps >> phase) {
+      sector.push_back(phase < 0 ? -1 : 1);
     }
-
-    PauliOperator reduced;
-    for (auto &kv : HPrime) {
-      auto term = kv.second;
-      if (term.ops().empty()) {
-        reduced += PauliOperator(term.coeff());
-      } else {
-        std::map<int, std::string> newTerm;
-        double phase = 1.0;
-
-        for (auto &termKv : term.ops()) {
-          if (keep_sites.find(termKv.first) != keep_sites.end()) {
-            newTerm.insert({termKv.first, termKv.second});
-          }
-
-          if (Z2_dict.count(termKv.first)) {
-            phase *= Z2_dict[termKv.first];
-          }
-        }
-        reduced += PauliOperator(newTerm, phase * term.coeff());
-      }
+    if (sector.size() != taus.size()) {
+      xacc::error("phase-sector must provide " + std::to_string(taus.size()) +
+                  " phases.");
     }
-
-    // Get the ground state energy to check if this is the
-    // minimizing sector
-    auto reducedEnergy = computeGroundStateEnergy(reduced, n);
-    if (reducedEnergy < energy) {
-      energy = reducedEnergy;
-      actualReduced = reduced;
+    actualReduced = reduce(HPrime, n, sites, sector);
+  } else if (xacc::optionExists("qubit-tapering-hf")) {
+    if (!xacc::optionExists("n-electrons")) {
+      xacc::error("qubit-tapering-hf requires n-electrons.");
+    }
+    int nElectrons = std::stoi(xacc::getOption("n-electrons"));
+    BinaryPauliTerm occupied;
+    for (int q = 0; q < nElectrons; q++) {
+      occupied.set(q, 'X');
+    }
+    for (int i = 0; i < taus.size(); i++) {
+      sector[i] = parity(taus[i].z, occupied.x) ? -1 : 1;
+    }
+    actualReduced = reduce(HPrime, n, sites, sector);
+  } else {
+    // Get the ground state energy of every sector
+    // to find the minimizing one
+    for (int s = 0; s < (1 << taus.size()); s++) {
+      std::vector<int> phases(taus.size());
+      for (int i = 0; i < taus.size(); i++) {
+        phases[i] = (s >> i) & 1 ? -1 : 1;
+      }
+      auto reduced = reduce(HPrime, n, sites, phases);
+      auto reducedEnergy =
+          computeGroundStateEnergy(reduced, n - (int)taus.size());
+      if (!haveEnergy || reducedEnergy < energy) {
+        energy = reducedEnergy;
+        sector = phases;
+        actualReduced = reduced;
+        haveEnergy = true;
+      }
     }
   }
 
-  counter = 0;
-  std::map<int, int> keepSites2Logical;
-  for (auto &i : keep_sites) {
-    keepSites2Logical.insert({i, counter});
-    counter++;
-  }
-
-  actualReduced.mapQubitSites(keepSites2Logical);
+  auto reducedOp = actualReduced.toPauliOperator();
 
   std::stringstream s;
   s << std::setprecision(12) << energy;
-  xacc::info("Reduced Hamiltonian:" + actualReduced.toString() +
-             ", with energy = " + s.str());
+  xacc::info("Reduced Hamiltonian:" + reducedOp.toString() +
+             (haveEnergy ? ", with energy = " + s.str() : ""));
   if (xacc::optionExists("qubit-tapering-show")) {
     xacc::info("Exiting XACC.");
     xacc::Finalize();
     exit(0);
   }
 
-  auto newIR = actualReduced.toXACCIR();
+  auto newIR = reducedOp.toXACCIR();
 
   // See if we have an ansatz and if so grab
   // it and add it to the reduced IR
@@ -311,14 +266,33 @@ std::shared_ptr<IR> QubitTapering::transform(std::shared_ptr<IR> ir) {
   return newIR;
 }
 
-const double QubitTapering::computeGroundStateEnergy(PauliOperator &op,
-                                                     const int n) {
+const double
+QubitTapering::computeGroundStateEnergy(const BinaryPauliOperator &op,
+                                        const int n) {
+  if (n > 30) {
+    xacc::error("QubitTapering: cannot search the sectors of a " +
+                std::to_string(n) +
+                " qubit reduced Hamiltonian, use phase-sector or "
+                "qubit-tapering-hf.");
+  }
+
+  // A Pauli string i^(x.z) X^x Z^z maps |b> to i^(x.z) (-1)^(z.b) |b ^ x>,
+  // the PauliMask form shared with the matrix-free diagonalize backend
+  std::vector<PauliMask> masks;
+  for (auto &kv : op.getTerms()) {
+    PauliMask m;
+    m.x = kv.first.first.x[0];
+    m.z = kv.first.first.z[0];
+    m.nY = __builtin_popcountll(m.x & m.z);
+    m.coeff = kv.second;
+    masks.push_back(m);
+  }
 
-    auto data = op.toDenseMatrix(n).data();
-    Eigen::MatrixXcd A = Eigen::Map<Eigen::MatrixXcd>(data, std::pow(2,n),std::pow(2,n));
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> es(A);
-    auto reducedEnergy = es.eigenvalues()[0];
-    return reducedEnergy;
+  // Only the lowest eigenvalue is needed, so
+  // the eigenvector pass is skipped
+  LanczosSolver solver(PauliSumMatVec(masks), std::size_t(1) << n, 300);
+  solver.computeTwoPass(Eigen::VectorXcd(), false);
+  return solver.eigenvalue();
 }
 
 } // namespace vqe
@@ -3,8 +3,8 @@
 
 #include "IRTransformation.hpp"
 #include "PauliOperator.hpp"
+#include "BinaryPauliOperator.hpp"
 #include "OptionsProvider.hpp"
-#include <Eigen/Dense>
 
 using namespace xacc::quantum;
 
@@ -15,6 +15,18 @@ namespace vqe {
  * QubitTapering is an IRTransformation that implements
  * the Hamiltonian reduction scheme for discrete
  * Z2 symmetries as described in https://arxiv.org/pdf/1701.08213.pdf.
+ *
+ * The Z-type symmetry generators are computed as a basis of the GF(2)
+ * null space of the X part of the bit-packed tableau, so finding them
+ * is polynomial in the number of qubits and terms. Each generator tau_i
+ * has a qubit q_i that no other generator acts on, and the Clifford
+ * U_i = (tau_i + X_qi) H_qi / 2 maps tau_i to Z_qi. It is applied term
+ * by term, after which Z_qi is replaced by the sector eigenvalue.
+ *
+ * The sector is given by phase-sector, taken from the Hartree-Fock
+ * state with qubit-tapering-hf, or otherwise found by computing the
+ * ground state energy of every sector with a matrix-free Lanczos
+ * solver.
  */
 class QubitTapering : public IRTransformation, public OptionsProvider {
 
@@ -31,65 +43,39 @@ public:
   virtual OptionPairs getOptions() {
     OptionPairs desc {{"phase-sector",
                         "Provide the +-1 vector."},{
+        "qubit-tapering-hf",
+        "Choose the sector of the Hartree-Fock state with n-electrons "
+        "occupied spin orbitals (Jordan-Wigner ordering)."},{
         "qubit-tapering-show",
         "Create and display reduced hamiltonian, but then exit."}};
     return desc;
   }
 
 private:
-  Eigen::MatrixXi computeTableaux(PauliOperator &H, const int nQubits);
-  std::vector<std::vector<int>> generateCombinations(
-      const int nQubits, std::function<void(std::vector<int> &)> &&f =
-                             [](std::vector<int> &tmp) { return; });
-  int binaryVectorInnerProduct(std::vector<int> &bv1, std::vector<int> &bv2);
-  const double computeGroundStateEnergy(PauliOperator &op, const int n);
-
-  Eigen::MatrixXi gauss(Eigen::MatrixXi& A, std::vector<int> &pivotCols) {
-     int n = A.rows();
-     int m = A.cols();
-
-     int sc = 0;
-
-     for (int i = 0; i < m; i++) {
-         bool found_row = false;
-         int ip = i-sc;
-         for (int k = ip; k < n; k++) {
-             if (A(k,i) == 1) {
-                 found_row = true;
-
-                 if (k > ip) {
-                     for (int j = i; j < m; j++) {
-                         auto tmp = A(k,j);
-                         A(k,j) = A(ip,j);
-                         A(ip,j) = tmp;
-                     }
-                 }
-
-                 for (int l = ip+1; l < n; l++) {
-                     if (A(l,i) != 0) {
-                         for (int j = ip; j < m; j++) {
-                             A(l,j) = (A(l,j)+A(ip,j)) %2;
-                         }
-                     }
-                 }
-                 break;
-             }
-         }
-         if (!found_row) sc += 1;
-     }
-
-    unsigned row2 = 0;
-    for (unsigned col = 0; col < A.cols() && row2 < A.rows(); col++) {
-      if (std::fabs(A(row2, col)) < 1e-12)
-        continue;
-
-      pivotCols.push_back(col);
-      row2++;
-    }
-
-     return A;
-
-  }
+  /**
+   * Compute the Z-type symmetry generators of H, and for each
+   * the qubit that only it acts on.
+   */
+  void findSymmetries(const BinaryPauliOperator &H, const int n,
+                      std::vector<BinaryPauliTerm> &taus,
+                      std::vector<int> &sites);
+
+  /**
+   * Conjugate the term t with coefficient c by (tau + X_q) H_q / 2.
+   */
+  void conjugate(BinaryPauliTerm &t, std::complex<double> &c,
+                 const BinaryPauliTerm &tau, const int q);
+
+  /**
+   * Replace Z on the tapered sites by the sector eigenvalues and
+   * relabel the kept sites to 0, 1, ...
+   */
+  BinaryPauliOperator reduce(const BinaryPauliOperator &HPrime, const int n,
+                             const std::vector<int> &sites,
+                             const std::vector<int> &sector);
+
+  const double computeGroundStateEnergy(const BinaryPauliOperator &op,
+                                        const int n);
 };
 } // namespace vqe
 } // namespace xacc
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright (c) 2017 UT-Battelle, LLC.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * and Eclipse Distribution License v1.0 which accompanies this
+ * distribution. The Eclipse Public License is available at
+ * http://www.eclipse.org/legal/epl-v10.html and the Eclipse Distribution
+ *License is available at https://eclipse.org/org/documents/edl-v10.php
+ *
+ * Contributors:
+ *   Alexander J. McCaskey - initial API and implementation
+ *******************************************************************************/
+#include "HamiltonianTruncation.hpp"
+#include "PauliOperator.hpp"
+#include "XACC.hpp"
+#include <gtest/gtest.h>
+#include "Eigen/Dense"
+
+using namespace xacc::vqe;
+
+const double groundStateEnergy(PauliOperator &op, const int n) {
+  auto data = op.toDenseMatrix(n).data();
+  Eigen::MatrixXcd A =
+      Eigen::Map<Eigen::MatrixXcd>(data, std::pow(2, n), std::pow(2, n));
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> es(A);
+  return es.eigenvalues()[0];
+}
+
+TEST(HamiltonianTruncationTester, checkTruncate) {
+
+  PauliOperator H;
+  H.fromString("(-0.0988349,0) + (0.171201,0) Z0 + (0.171201,0) Z1 + "
+               "(-0.222796,0) Z2 + (-0.222796,0) Z3 + (0.168623,0) Z0 Z1 + "
+               "(0.120546,0) Z0 Z2 + (0.165868,0) Z0 Z3 + (0.165868,0) Z1 Z2 + "
+               "(0.120546,0) Z1 Z3 + (0.174349,0) Z2 Z3 + "
+               "(0.0453219,0) X0 X1 Y2 Y3 + (0.0004,0) X0 Z1 X2 + "
+               "(0.0007,0) Y0 Z1 Y2 + (1e-08,0) X1 X3");
+
+  HamiltonianTruncation truncation;
+  double bound;
+
+  // Nothing is dropped without threshold and budget
+  auto same = truncation.truncate(H, 0.0, 0.0, bound);
+  EXPECT_TRUE(same == H);
+  EXPECT_EQ(0.0, bound);
+
+  // The threshold only drops the 1e-8 term
+  auto thresholded = truncation.truncate(H, 1e-6, 0.0, bound);
+  EXPECT_EQ(H.nTerms() - 1, thresholded.nTerms());
+  EXPECT_NEAR(1e-8, bound, 1e-14);
+
+  // A budget of 1e-3 drops the 1e-8 and 4e-4 terms, but not 7e-4
+  auto budgeted = truncation.truncate(H, 0.0, 1e-3, bound);
+  EXPECT_EQ(H.nTerms() - 2, budgeted.nTerms());
+  EXPECT_NEAR(4.0001e-4, bound, 1e-12);
+
+  auto exact = groundStateEnergy(H, 4);
+  auto approx = groundStateEnergy(budgeted, 4);
+  EXPECT_LE(std::fabs(exact - approx), bound);
+
+  // The identity is always kept
+  auto all = truncation.truncate(H, 1.0, 0.0, bound);
+  EXPECT_EQ(1, all.nTerms());
+  EXPECT_TRUE(all == PauliOperator(-0.0988349));
+}
+
+TEST(HamiltonianTruncationTester, checkVariableTerms) {
+
+  PauliOperator H;
+  H.fromString("(-0.0988349,0) + (0.171201,0) Z0 + (0.0004,0) X0 X1");
+  H += PauliOperator({{0, "Y"}, {1, "X"}}, std::complex<double>(1e-5),
+                      "theta");
+  H += PauliOperator(std::complex<double>(2e-5), "phi");
+
+  HamiltonianTruncation truncation;
+  double bound;
+
+  // Only the 4e-4 term is dropped, the variable terms
+  // are kept with their variables
+  auto truncated = truncation.truncate(H, 0.0, 1e-3, bound);
+  PauliOperator expected;
+  expected.fromString("(-0.0988349,0) + (0.171201,0) Z0");
+  expected += PauliOperator({{0, "Y"}, {1, "X"}}, std::complex<double>(1e-5),
+                             "theta");
+  expected += PauliOperator(std::complex<double>(2e-5), "phi");
+  EXPECT_TRUE(truncated == expected);
+  EXPECT_NEAR(4e-4, bound, 1e-12);
+}
+
+TEST(HamiltonianTruncationTester, checkTransform) {
+
+  PauliOperator H;
+  H.fromString("(-0.0988349,0) + (0.171201,0) Z0 + (-0.222796,0) Z1 + "
+               "(0.0453219,0) X0 X1 + (0.0004,0) Y0 Y1");
+
+  xacc::setOption("truncation-error-budget", "1e-3");
+  HamiltonianTruncation truncation;
+  auto newIR = truncation.transform(H.toXACCIR());
+
+  PauliOperator actual, expected;
+  actual.fromXACCIR(newIR);
+  expected.fromString("(-0.0988349,0) + (0.171201,0) Z0 + (-0.222796,0) Z1 "
+                      "+ (0.0453219,0) X0 X1");
+  EXPECT_TRUE(actual == expected);
+  EXPECT_NEAR(4e-4, truncation.getErrorBound(), 1e-12);
+}
+
+int main(int argc, char **argv) {
+  xacc::Initialize(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  auto ret = RUN_ALL_TESTS();
+  xacc::Finalize();
+  return ret;
+}
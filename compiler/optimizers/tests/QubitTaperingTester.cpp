@@ -69,7 +69,7 @@ TEST(QubitTaperingTester, checkH2) {
 
   PauliOperator expected, actual, op;
   op.fromXACCIR(newIR);
-  expected.fromString("(-0.335683,0) I + (-0.780643,0) Z0 + (0.181625,0) X0");
+  expected.fromString("(-0.335683,0) I + (0.780643,0) Z0 + (0.181625,0) X0");
 
   actual.fromXACCIR(newIR);
 
@@ -113,7 +113,7 @@ TEST(QubitTaperingTester, checkH2WithAnsatz) {
     auto newIR = tapering.transform(tir);
 
     PauliOperator expected, actual;
-    expected.fromString("(-0.335683,0) I + (-0.780643,0) Z0 + (0.181625,0) X0");
+    expected.fromString("(-0.335683,0) I + (0.780643,0) Z0 + (0.181625,0) X0");
 
     actual.fromXACCIR(newIR);
 
@@ -178,6 +178,24 @@ TEST(QubitTaperingTester, checkSixQubit) {
 
   }
 }
+TEST(QubitTaperingTester, checkH2HartreeFock) {
+
+  auto c = xacc::getService<xacc::Compiler>("fermion");
+  auto ir = c->compile(src);
+
+  // The Hartree-Fock sector is the ground state sector for H2
+  xacc::setOption("n-electrons", "2");
+  xacc::setOption("qubit-tapering-hf", "");
+  QubitTapering tapering;
+  auto newIR = tapering.transform(ir);
+
+  PauliOperator expected, actual;
+  expected.fromString("(-0.335683,0) I + (0.780643,0) Z0 + (0.181625,0) X0");
+  actual.fromXACCIR(newIR);
+
+  EXPECT_TRUE(actual == expected);
+}
+
 int main(int argc, char **argv) {
   xacc::Initialize(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
@@ -30,6 +30,12 @@
  **********************************************************************************/
 #include <gtest/gtest.h>
 #include "FermionCompiler.hpp"
+#include "FermionTermReader.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <unistd.h>
 #include "XACC.hpp"
 
 using namespace xacc::vqe;
@@ -167,6 +173,102 @@ TEST(FermionCompilerTester,checkSimpleCompile) {
 	ir = compiler->compile(code, acc);
 	xacc::Finalize();
 }
+
+TEST(FermionCompilerTester,checkIntegralFiles) {
+
+	// H2 / sto-3g, the same Hamiltonian as an FCIDUMP file and as kernel terms
+	const std::string fcidump = R"fcidump( &FCI NORB=  2,NELEC=  2,MS2= 0,
+  ORBSYM=1,1,
+  ISYM=1,
+ &END
+  0.6744931033260D+00   1   1   1   1
+  0.6634720448605D+00   1   1   2   2
+  0.1812875358080D+00   1   2   1   2
+  0.6973979494693D+00   2   2   2   2
+ -1.252477303982147   1   1   0   0
+ -0.4759344611440753   2   2   0   0
+  0.7137758743754461   0   0   0   0
+)fcidump";
+
+	const std::string kernel = R"kernel(__qpu__ kernel() {
+	0.7137758743754461
+	-1.252477303982147 0 1 0 0
+	0.337246551663004 0 1 1 1 1 0 0 0
+	0.0906437679061661 0 1 1 1 3 0 2 0
+	0.0906437679061661 0 1 2 1 0 0 2 0
+	0.3317360224302783 0 1 2 1 2 0 0 0
+	0.0906437679061661 0 1 3 1 1 0 2 0
+	0.3317360224302783 0 1 3 1 3 0 0 0
+	0.337246551663004 1 1 0 1 0 0 1 0
+	0.0906437679061661 1 1 0 1 2 0 3 0
+	-1.252477303982147 1 1 1 0
+	0.0906437679061661 1 1 2 1 0 0 3 0
+	0.3317360224302783 1 1 2 1 2 0 1 0
+	0.0906437679061661 1 1 3 1 1 0 3 0
+	0.3317360224302783 1 1 3 1 3 0 1 0
+	0.3317360224302783 2 1 0 1 0 0 2 0
+	0.0906437679061661 2 1 0 1 2 0 0 0
+	0.3317360224302783 2 1 1 1 1 0 2 0
+	0.0906437679061661 2 1 1 1 3 0 0 0
+	-0.4759344611440753 2 1 2 0
+	0.0906437679061661 2 1 3 1 1 0 0 0
+	0.3486989747346679 2 1 3 1 3 0 2 0
+	0.3317360224302783 3 1 0 1 0 0 3 0
+	0.0906437679061661 3 1 0 1 2 0 1 0
+	0.3317360224302783 3 1 1 1 1 0 3 0
+	0.0906437679061661 3 1 1 1 3 0 1 0
+	0.0906437679061661 3 1 2 1 0 0 1 0
+	0.3486989747346679 3 1 2 1 2 0 3 0
+	-0.4759344611440753 3 1 3 0
+})kernel";
+
+	// Write the files into a fresh temporary directory
+	auto tmp = std::getenv("TMPDIR");
+	auto dirTemplate = std::string(tmp ? tmp : "/tmp") + "/fermion-reader-XXXXXX";
+	ASSERT_TRUE(mkdtemp(&dirTemplate[0]) != nullptr);
+	auto fcidumpFile = dirTemplate + "/h2.fcidump";
+	auto binaryFile = dirTemplate + "/h2.bin";
+
+	std::ofstream(fcidumpFile) << fcidump;
+
+	auto toMap = [](const FermionTermArena& arena) {
+		std::map<std::vector<std::pair<int, int>>, double> terms;
+		for (int t = 0; t < arena.nTerms(); t++) {
+			std::vector<std::pair<int, int>> ops(
+					arena.operators.begin() + arena.offsets[t],
+					arena.operators.begin() + arena.offsets[t + 1]);
+			terms[ops] += arena.coefficients[t];
+		}
+		return terms;
+	};
+
+	FermionTermReader reader(2);
+	auto expected = toMap(reader.parseKernel(
+			kernel.data() + kernel.find('\n') + 1,
+			kernel.data() + kernel.rfind('}')));
+	EXPECT_EQ(29, expected.size());
+
+	int nOrbitals = 0;
+	auto terms = toMap(reader.read(fcidumpFile, nOrbitals));
+	EXPECT_EQ(2, nOrbitals);
+	EXPECT_EQ(expected.size(), terms.size());
+	for (auto& kv : expected) {
+		EXPECT_NEAR(kv.second, terms[kv.first], 1e-10);
+	}
+
+	// Round trip through the binary format
+	auto records = reader.readFCIDUMPRecords(fcidumpFile, nOrbitals);
+	FermionTermReader::writeBinary(binaryFile, nOrbitals, records);
+	nOrbitals = 0;
+	auto binaryTerms = toMap(reader.read(binaryFile, nOrbitals));
+	EXPECT_EQ(2, nOrbitals);
+	EXPECT_TRUE(binaryTerms == terms);
+
+	std::remove(fcidumpFile.c_str());
+	std::remove(binaryFile.c_str());
+	rmdir(dirTemplate.c_str());
+}
+
 int main(int argc, char** argv) {
    ::testing::InitGoogleTest(&argc, argv);
    return RUN_ALL_TESTS();
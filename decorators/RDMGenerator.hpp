@@ -2,6 +2,7 @@
 #define RDMGENERATOR_HPP_
 
 #include "Accelerator.hpp"
+#include "FermionIntegrals.hpp"
 #include <unsupported/Eigen/CXX11/Tensor>
 
 namespace xacc {
@@ -37,27 +38,21 @@ public:
   Eigen::Tensor<std::complex<double>, 4> rho_pqrs;
 
   /**
-   * The 1-body electron overlap integrals
+   * The 1 and 2-body electron integrals
    */
-  Eigen::Tensor<std::complex<double>, 2> hpq;
+  std::shared_ptr<const FermionIntegrals> integrals;
 
   /**
-   * The 2-body electron overlap integrals
-   */
-  Eigen::Tensor<std::complex<double>, 4> hpqrs;
-
-  /**
-   * The Constructor, takes a built VQEProgram
-   * describing the high-level second quantized
-   * fermionic hamiltonian.
+   * The Constructor, takes the number of qubits, the
+   * Accelerator to run on and the integrals of the
+   * high-level second quantized fermionic hamiltonian.
    *
    * @param p
    */
   RDMGenerator(const int nQubits, std::shared_ptr<Accelerator> acc,
-               Eigen::Tensor<std::complex<double>, 2> &hpq_,
-               Eigen::Tensor<std::complex<double>, 4> &hpqrs_)
+               std::shared_ptr<const FermionIntegrals> integrals_)
       : _nQubits(nQubits), rho_pq(nQubits, nQubits), qpu(acc),
-        rho_pqrs(nQubits, nQubits, nQubits, nQubits), hpq(hpq_), hpqrs(hpqrs_) {
+        rho_pqrs(nQubits, nQubits, nQubits, nQubits), integrals(integrals_) {
   }
 
   const int nQubits() { return _nQubits; }
@@ -81,18 +81,28 @@ RDMPurificationDecorator::execute(
   xacc::unsetOption("no-fermion-transformation");
 
   auto energy = fk->E_nuc();
-  auto hpq = fk->hpq(nQubits);
-  auto hpqrs = fk->hpqrs(nQubits);
-  RDMGenerator generator(buffer->size(), decoratedAccelerator, hpq, hpqrs);
+  auto integrals = fk->integrals(nQubits);
+  RDMGenerator generator(buffer->size(), decoratedAccelerator, integrals);
   buffers = generator.generate(ansatz, qubitMap);
 
-  Eigen::Tensor<double,4> realpqrs = hpqrs.real();
-  auto pqrstmp = realpqrs.data();
-  std::vector<double> hpqrs_vec(pqrstmp, pqrstmp + hpqrs.size());
-
-  Eigen::Tensor<double,2> realpq = hpq.real();
-  auto pqtmp = realpq.data();
-  std::vector<double> hpq_vec(pqtmp, pqtmp + hpq.size());
+  // Dense column major copies for the buffer extra info
+  std::vector<double> hpqrs_vec, hpq_vec;
+  hpqrs_vec.reserve(nQubits * nQubits * nQubits * nQubits);
+  hpq_vec.reserve(nQubits * nQubits);
+  for (int s = 0; s < nQubits; s++) {
+    for (int r = 0; r < nQubits; r++) {
+      for (int q = 0; q < nQubits; q++) {
+        for (int p = 0; p < nQubits; p++) {
+          hpqrs_vec.push_back(integrals->hpqrs(p, q, r, s));
+        }
+      }
+    }
+  }
+  for (int q = 0; q < nQubits; q++) {
+    for (int p = 0; p < nQubits; p++) {
+      hpq_vec.push_back(integrals->hpq(p, q));
+    }
+  }
 
   //   auto rho_pq = generator.rho_pq;
   T4 rho_pqrs = generator.rho_pqrs;
@@ -106,7 +116,7 @@ RDMPurificationDecorator::execute(
       for (int r = 0; r < nQubits; r++) {
         for (int s = 0; s < nQubits; s++) {
           bad_energy +=
-              0.5 * std::real(hpqrs(p, q, r, s) *
+              0.5 * std::real(integrals->hpqrs(p, q, r, s) *
                               (rho_pqrs(p, q, s, r) + rho_pqrs(r, s, q, p)));
         }
       }
@@ -121,7 +131,7 @@ RDMPurificationDecorator::execute(
   T2 bad_rhopq_tensor = rho_pqrs.trace(cc2);
   for (int p = 0; p < nQubits; p++) {
     for (int q = 0; q < nQubits; q++) {
-      bad_energy += 0.5 * std::real(hpq(p, q) * (bad_rhopq_tensor(p, q) +
+      bad_energy += 0.5 * std::real(integrals->hpq(p, q) * (bad_rhopq_tensor(p, q) +
                                                  bad_rhopq_tensor(q, p)));
     }
   }
@@ -218,7 +228,7 @@ RDMPurificationDecorator::execute(
     for (int q = 0; q < nQubits; q++) {
       for (int r = 0; r < nQubits; r++) {
         for (int s = 0; s < nQubits; s++) {
-          energy += 0.5 * std::real(hpqrs(p, q, r, s) *
+          energy += 0.5 * std::real(integrals->hpqrs(p, q, r, s) *
                                     (rdm(p, q, s, r) + rdm(r, s, q, p)));
         }
       }
@@ -228,7 +238,7 @@ RDMPurificationDecorator::execute(
 
   for (int p = 0; p < nQubits; p++) {
     for (int q = 0; q < nQubits; q++) {
-      energy += 0.5 * std::real(hpq(p, q) *
+      energy += 0.5 * std::real(integrals->hpq(p, q) *
                                 (rhopq_tensor(p, q) + rhopq_tensor(q, p)));
     }
   }
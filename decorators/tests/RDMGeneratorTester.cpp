@@ -110,8 +110,7 @@ TEST(RDMGeneratorTester, checkGround) {
         std::dynamic_pointer_cast<FermionKernel>(ir->getKernels()[0]);
     xacc::unsetOption("no-fermion-transformation");
     auto energy = fermionKernel->E_nuc();
-    auto hpq = fermionKernel->hpq(nQubits);
-    auto hpqrs = fermionKernel->hpqrs(nQubits);
+    auto integrals = fermionKernel->integrals(nQubits);
 
     // Create the UCCSD ansatz and evaluate
     // at the known optimal angles
@@ -126,7 +125,7 @@ TEST(RDMGeneratorTester, checkGround) {
     // Create the 2-RDM
     std::vector<int> qubitMap {1,3,5,7}; // map to physical qubits
     ruccsd->mapBits(qubitMap);
-    RDMGenerator generator(nQubits, accelerator, hpq, hpqrs);
+    RDMGenerator generator(nQubits, accelerator, integrals);
     auto buffers = generator.generate(ruccsd, qubitMap);
 
     EXPECT_EQ(buffers.size(), 54);
@@ -142,7 +141,7 @@ TEST(RDMGeneratorTester, checkGround) {
         for (int r = 0; r < nQubits; r++) {
           for (int s = 0; s < nQubits; s++) {
             energy +=
-                0.5 * std::real(hpqrs(p, q, r, s) *
+                0.5 * std::real(integrals->hpqrs(p, q, r, s) *
                                 (rho_pqrs(p, q, s, r) + rho_pqrs(r, s, q, p)));
           }
         }
@@ -153,7 +152,7 @@ TEST(RDMGeneratorTester, checkGround) {
     // Compute the 1 rdm contribution to the energy
     for (int p = 0; p < nQubits; p++) {
       for (int q = 0; q < nQubits; q++) {
-        energy += 0.5 * std::real(hpq(p, q) * (rho_pq(p, q) + rho_pq(q, p)));
+        energy += 0.5 * std::real(integrals->hpq(p, q) * (rho_pq(p, q) + rho_pq(q, p)));
       }
     }
     std::cout << "ENERGY: " << energy << "\n";
@@ -0,0 +1,397 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef VQE_IR_BINARYPAULIOPERATOR_HPP_
+#define VQE_IR_BINARYPAULIOPERATOR_HPP_
+
+#include "PauliOperator.hpp"
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+using namespace xacc::quantum;
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * BinaryPauliTerm is the symplectic (bit-packed) representation of
+ * a Pauli string on up to 64 * NWORDS qubits. Bit q of x (z) is set
+ * if the string has an X (Z) component on qubit q, a Y sets both.
+ *
+ * Products, commutation checks and hashing are O(NWORDS) integer
+ * operations, no strings or maps are involved.
+ */
+class BinaryPauliTerm {
+
+public:
+  static const int NWORDS = 2;
+
+  std::uint64_t x[NWORDS];
+  std::uint64_t z[NWORDS];
+
+  BinaryPauliTerm() {
+    for (int w = 0; w < NWORDS; w++) {
+      x[w] = 0;
+      z[w] = 0;
+    }
+  }
+
+  BinaryPauliTerm(const std::map<int, std::string> &ops) : BinaryPauliTerm() {
+    for (auto &kv : ops) {
+      set(kv.first, kv.second[0]);
+    }
+  }
+
+  /**
+   * Set the Pauli acting on the given qubit,
+   * pauli is one of 'I', 'X', 'Y', or 'Z'.
+   */
+  void set(const int qubit, const char pauli) {
+    if (qubit >= 64 * NWORDS) {
+      xacc::error("BinaryPauliTerm supports at most " +
+                  std::to_string(64 * NWORDS) + " qubits.");
+    }
+    auto w = qubit / 64;
+    auto bit = std::uint64_t(1) << (qubit % 64);
+    x[w] &= ~bit;
+    z[w] &= ~bit;
+    if (pauli == 'X' || pauli == 'Y') {
+      x[w] |= bit;
+    }
+    if (pauli == 'Z' || pauli == 'Y') {
+      z[w] |= bit;
+    }
+  }
+
+  const char get(const int qubit) const {
+    auto w = qubit / 64;
+    auto bit = std::uint64_t(1) << (qubit % 64);
+    bool hasX = x[w] & bit, hasZ = z[w] & bit;
+    return hasX ? (hasZ ? 'Y' : 'X') : (hasZ ? 'Z' : 'I');
+  }
+
+  const bool isIdentity() const {
+    for (int w = 0; w < NWORDS; w++) {
+      if (x[w] || z[w]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const int weight() const {
+    int count = 0;
+    for (int w = 0; w < NWORDS; w++) {
+      count += __builtin_popcountll(x[w] | z[w]);
+    }
+    return count;
+  }
+
+  /**
+   * Return true if this term commutes with the other term,
+   * i.e. the symplectic inner product is even.
+   */
+  const bool commutes(const BinaryPauliTerm &other) const {
+    int parity = 0;
+    for (int w = 0; w < NWORDS; w++) {
+      parity ^= __builtin_popcountll((x[w] & other.z[w]) ^ (z[w] & other.x[w]));
+    }
+    return !(parity & 1);
+  }
+
+  /**
+   * Compute the product this * other. The resulting Pauli string
+   * is written to result and the product picks up a phase i^k,
+   * with k (mod 4) returned.
+   */
+  const int multiply(const BinaryPauliTerm &other,
+                     BinaryPauliTerm &result) const {
+    int k = 0;
+    for (int w = 0; w < NWORDS; w++) {
+      auto x1 = x[w], z1 = z[w], x2 = other.x[w], z2 = other.z[w];
+      auto X1 = x1 & ~z1, Y1 = x1 & z1, Z1 = ~x1 & z1;
+      auto X2 = x2 & ~z2, Y2 = x2 & z2, Z2 = ~x2 & z2;
+      // XY = iZ, YZ = iX, ZX = iY, and -i for the reverse order
+      auto plus = (X1 & Y2) | (Y1 & Z2) | (Z1 & X2);
+      auto minus = (Y1 & X2) | (Z1 & Y2) | (X1 & Z2);
+      k += __builtin_popcountll(plus) - __builtin_popcountll(minus);
+      result.x[w] = x1 ^ x2;
+      result.z[w] = z1 ^ z2;
+    }
+    return ((k % 4) + 4) % 4;
+  }
+
+  /**
+   * Return the map representation used by PauliOperator.
+   */
+  std::map<int, std::string> toOps() const {
+    std::map<int, std::string> ops;
+    for (int w = 0; w < NWORDS; w++) {
+      auto bits = x[w] | z[w];
+      while (bits) {
+        auto q = 64 * w + __builtin_ctzll(bits);
+        ops.insert({q, std::string(1, get(q))});
+        bits &= bits - 1;
+      }
+    }
+    return ops;
+  }
+
+  bool operator==(const BinaryPauliTerm &other) const {
+    for (int w = 0; w < NWORDS; w++) {
+      if (x[w] != other.x[w] || z[w] != other.z[w]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const std::size_t hash() const {
+    std::size_t h = 0;
+    for (int w = 0; w < NWORDS; w++) {
+      h ^= std::hash<std::uint64_t>()(x[w]) + 0x9e3779b97f4a7c15ULL + (h << 6) +
+           (h >> 2);
+      h ^= std::hash<std::uint64_t>()(z[w]) + 0x9e3779b97f4a7c15ULL + (h << 6) +
+           (h >> 2);
+    }
+    return h;
+  }
+};
+
+/**
+ * BinaryPauliOperator is a sum of BinaryPauliTerms with complex
+ * coefficients (and optional variable names, as in PauliOperator),
+ * stored in a hash map keyed on the bit-packed term.
+ *
+ * It is meant for the hot loops of fermion to spin transformations,
+ * results are converted to a PauliOperator only once at the end.
+ */
+class BinaryPauliOperator {
+
+public:
+  using Key = std::pair<BinaryPauliTerm, std::string>;
+
+  struct KeyHash {
+    std::size_t operator()(const Key &k) const {
+      return k.second.empty()
+                 ? k.first.hash()
+                 : k.first.hash() ^ (std::hash<std::string>()(k.second) << 1);
+    }
+  };
+
+  using TermMap = std::unordered_map<Key, std::complex<double>, KeyHash>;
+
+  BinaryPauliOperator() {}
+
+  BinaryPauliOperator(const std::complex<double> c,
+                      const std::string var = "") {
+    addTerm(BinaryPauliTerm(), c, var);
+  }
+
+  BinaryPauliOperator(const BinaryPauliTerm &t, const std::complex<double> c,
+                      const std::string var = "") {
+    addTerm(t, c, var);
+  }
+
+  BinaryPauliOperator(PauliOperator &op) {
+    for (auto &kv : op.getTerms()) {
+      addTerm(BinaryPauliTerm(kv.second.ops()), kv.second.coeff(),
+              std::get<1>(kv.second));
+    }
+  }
+
+  void addTerm(const BinaryPauliTerm &t, const std::complex<double> c,
+               const std::string &var = "") {
+    auto it = terms.find(Key(t, var));
+    if (it == terms.end()) {
+      terms.insert({Key(t, var), c});
+    } else {
+      it->second += c;
+    }
+  }
+
+  BinaryPauliOperator &operator+=(const BinaryPauliOperator &other) {
+    for (auto &kv : other.terms) {
+      addTerm(kv.first.first, kv.second, kv.first.second);
+    }
+    return *this;
+  }
+
+  BinaryPauliOperator &operator-=(const BinaryPauliOperator &other) {
+    for (auto &kv : other.terms) {
+      addTerm(kv.first.first, -kv.second, kv.first.second);
+    }
+    return *this;
+  }
+
+  BinaryPauliOperator &operator*=(const std::complex<double> c) {
+    for (auto &kv : terms) {
+      kv.second *= c;
+    }
+    return *this;
+  }
+
+  BinaryPauliOperator &operator*=(const BinaryPauliOperator &other) {
+    *this = *this * other;
+    return *this;
+  }
+
+  BinaryPauliOperator operator*(const BinaryPauliOperator &other) const {
+    static const std::complex<double> iPowers[4] = {
+        {1.0, 0.0}, {0.0, 1.0}, {-1.0, 0.0}, {0.0, -1.0}};
+
+    BinaryPauliOperator product;
+    product.terms.reserve(terms.size() * other.terms.size());
+    BinaryPauliTerm t;
+    for (auto &a : terms) {
+      for (auto &b : other.terms) {
+        auto k = a.first.first.multiply(b.first.first, t);
+        std::string var = a.first.second;
+        if (var.empty()) {
+          var = b.first.second;
+        } else if (!b.first.second.empty()) {
+          var += b.first.second;
+        }
+        product.addTerm(t, iPowers[k] * a.second * b.second, var);
+      }
+    }
+    return product;
+  }
+
+  BinaryPauliOperator operator+(const BinaryPauliOperator &other) const {
+    BinaryPauliOperator sum(*this);
+    sum += other;
+    return sum;
+  }
+
+  BinaryPauliOperator operator-(const BinaryPauliOperator &other) const {
+    BinaryPauliOperator diff(*this);
+    diff -= other;
+    return diff;
+  }
+
+  /**
+   * Remove all terms with coefficient magnitude below tol.
+   */
+  void simplify(const double tol = 1e-12) {
+    for (auto it = terms.begin(); it != terms.end();) {
+      if (std::abs(it->second) < tol) {
+        it = terms.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /**
+   * Return the hermitian conjugate, Pauli strings are
+   * hermitian so only the coefficients are conjugated.
+   */
+  BinaryPauliOperator hermitianConjugate() const {
+    BinaryPauliOperator conj(*this);
+    for (auto &kv : conj.terms) {
+      kv.second = std::conj(kv.second);
+    }
+    return conj;
+  }
+
+  const std::size_t nTerms() const { return terms.size(); }
+
+  const TermMap &getTerms() const { return terms; }
+
+  void clear() { terms.clear(); }
+
+  /**
+   * Serialize all terms to a flat byte string, used
+   * to exchange operators between MPI ranks.
+   */
+  std::string toBytes() const {
+    std::string bytes;
+    for (auto &kv : terms) {
+      auto &t = kv.first.first;
+      auto &var = kv.first.second;
+      std::uint32_t varLength = var.length();
+      bytes.append(reinterpret_cast<const char *>(t.x), sizeof(t.x));
+      bytes.append(reinterpret_cast<const char *>(t.z), sizeof(t.z));
+      bytes.append(reinterpret_cast<const char *>(&kv.second),
+                   sizeof(kv.second));
+      bytes.append(reinterpret_cast<const char *>(&varLength),
+                   sizeof(varLength));
+      bytes.append(var);
+    }
+    return bytes;
+  }
+
+  /**
+   * Add all terms of an operator serialized with toBytes.
+   */
+  void addBytes(const std::string &bytes) {
+    std::size_t pos = 0;
+    while (pos < bytes.size()) {
+      BinaryPauliTerm t;
+      std::complex<double> c;
+      std::uint32_t varLength;
+      std::memcpy(t.x, &bytes[pos], sizeof(t.x));
+      pos += sizeof(t.x);
+      std::memcpy(t.z, &bytes[pos], sizeof(t.z));
+      pos += sizeof(t.z);
+      std::memcpy(&c, &bytes[pos], sizeof(c));
+      pos += sizeof(c);
+      std::memcpy(&varLength, &bytes[pos], sizeof(varLength));
+      pos += sizeof(varLength);
+      addTerm(t, c, bytes.substr(pos, varLength));
+      pos += varLength;
+    }
+  }
+
+  /**
+   * Convert to a PauliOperator, dropping terms
+   * with (numerically) zero coefficients.
+   */
+  PauliOperator toPauliOperator() const {
+    PauliOperator op;
+    for (auto &kv : terms) {
+      if (std::abs(kv.second) > 1e-12) {
+        op += PauliOperator(kv.first.first.toOps(), kv.second,
+                            kv.first.second);
+      }
+    }
+    return op;
+  }
+
+protected:
+  TermMap terms;
+};
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
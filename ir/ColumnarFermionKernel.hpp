@@ -0,0 +1,128 @@
+#ifndef IR_COLUMNARFERMIONKERNEL_HPP_
+#define IR_COLUMNARFERMIONKERNEL_HPP_
+
+#include "FermionKernel.hpp"
+#include "FermionTermColumns.hpp"
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * The ColumnarFermionKernel is a FermionKernel whose terms are
+ * stored in FermionTermColumns instead of a list of
+ * FermionInstructions, so that large Hamiltonians can be iterated
+ * without chasing pointers (see getColumns()).
+ *
+ * The Function API is provided through adapters: getInstruction()
+ * and getInstructions() return FermionInstructions created from
+ * the columns, so changes to them are not reflected in the kernel.
+ * getInstruction is O(1).
+ */
+class ColumnarFermionKernel: public FermionKernel {
+
+protected:
+
+	FermionTermColumns columns;
+
+	void addTerms(FermionIntegrals& store) override {
+		std::vector<int> termSites;
+		for (int t = 0; t < columns.nTerms(); t++) {
+			auto& coeff = columns.coefficient(t);
+			if (std::imag(coeff) != 0.0) {
+				xacc::error("FermionKernel::integrals requires real coefficients.");
+			}
+			termSites.assign(columns.termSites(t),
+					columns.termSites(t) + columns.nOperators(t));
+			store.setTerm(termSites, std::real(coeff));
+		}
+	}
+
+	bool hasRealCoefficients() override {
+		for (int t = 0; t < columns.nTerms(); t++) {
+			if (std::imag(columns.coefficient(t)) != 0.0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+
+	ColumnarFermionKernel(std::string kernelName) :
+			FermionKernel(kernelName) {
+	}
+
+	ColumnarFermionKernel(std::string kernelName, FermionTermColumns&& terms) :
+			FermionKernel(kernelName), columns(std::move(terms)) {
+	}
+
+	std::shared_ptr<FermionKernel> clone() override {
+		return std::make_shared<ColumnarFermionKernel>(*this);
+	}
+
+	/**
+	 * Return the column storage of the terms.
+	 */
+	const FermionTermColumns& getColumns() const {
+		return columns;
+	}
+
+	const int nInstructions() override {
+		return columns.nTerms();
+	}
+
+	InstPtr getInstruction(const int idx) override {
+		if (idx < 0 || idx >= columns.nTerms()) {
+			xacc::error("Invalid instruction index - " + std::to_string(idx) + ".");
+		}
+		return columns.instruction(idx);
+	}
+
+	std::list<InstPtr> getInstructions() override {
+		std::list<InstPtr> insts;
+		for (int t = 0; t < columns.nTerms(); t++) {
+			insts.push_back(columns.instruction(t));
+		}
+		return insts;
+	}
+
+	void removeInstruction(const int idx) override {
+		integralStore.reset();
+		columns.removeTerm(idx);
+	}
+
+	void addInstruction(InstPtr instruction) override {
+		integralStore.reset();
+		columns.insertTerm(columns.nTerms(), instruction);
+	}
+
+	void replaceInstruction(const int idx, InstPtr replacingInst) override {
+		integralStore.reset();
+		columns.removeTerm(idx);
+		columns.insertTerm(idx, replacingInst);
+	}
+
+	void insertInstruction(const int idx, InstPtr newInst) override {
+		integralStore.reset();
+		columns.insertTerm(idx, newInst);
+	}
+
+	const std::string toString(const std::string& bufferVarName) override {
+		std::stringstream ss;
+		FermionInstruction inst(std::vector<std::pair<int, int>> { });
+		for (int t = 0; t < columns.nTerms(); t++) {
+			columns.load(t, inst);
+			ss << inst.toString("") << " + \n";
+		}
+		return ss.str().substr(0, ss.str().size() - 3);
+	}
+
+	const std::string toString() override {
+		return toString("");
+	}
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef IR_FERMIONINTEGRALS_HPP_
+#define IR_FERMIONINTEGRALS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * FermionIntegrals stores the real coefficients of a fermion
+ * Hamiltonian
+ *
+ *   H = E_nuc + sum hpq(p,q) a^dag_p a_q
+ *             + sum hpqrs(p,q,r,s) a^dag_p a^dag_q a_r a_s
+ *
+ * over n spin orbitals. With real orbitals hpqrs(p,q,r,s) is
+ * (ps|qr)/2 in chemist notation and has the 8-fold permutational
+ * symmetry of (ij|kl), and hpq is symmetric. When the terms have these
+ * symmetries, one value per symmetry class is stored in packed
+ * triangular arrays, i.e. n^4/8 instead of n^4 values, with O(1)
+ * index arithmetic. Otherwise the terms are kept in hash maps, so
+ * arbitrary Hamiltonians are still represented exactly.
+ *
+ * Terms with p == q or r == s vanish (a^dag_p a^dag_p = 0), their
+ * coefficients are reported as 0.
+ */
+class FermionIntegrals {
+
+protected:
+
+	int n;
+
+	double eNuc = 0.0;
+
+	bool packed = false;
+
+	std::vector<double> oneBody;
+	std::vector<double> twoBody;
+
+	// Terms by dense index, used while building and
+	// as the storage of Hamiltonians without the symmetries
+	std::unordered_map<std::size_t, double> oneBodyTerms;
+	std::unordered_map<std::size_t, double> twoBodyTerms;
+
+	const std::size_t denseIndex(const int p, const int q) const {
+		return (std::size_t) p * n + q;
+	}
+
+	const std::size_t denseIndex(const int p, const int q, const int r,
+			const int s) const {
+		return (((std::size_t) p * n + q) * n + r) * n + s;
+	}
+
+	static const bool equal(const double a, const double b) {
+		return std::fabs(a - b) <= 1e-10 * std::max(1.0, std::fabs(a));
+	}
+
+	const double twoBodyTerm(const int p, const int q, const int r,
+			const int s) const {
+		auto it = twoBodyTerms.find(denseIndex(p, q, r, s));
+		return it == twoBodyTerms.end() ? 0.0 : it->second;
+	}
+
+	/**
+	 * The 8 index orders of hpqrs(p,q,r,s) = (ps|qr)/2 related by
+	 * the permutational symmetry of (ij|kl).
+	 */
+	static void symmetryOrbit(const int p, const int q, const int r,
+			const int s, int orbit[8][4]) {
+		// chemist (ij|kl) = (ps|qr), and hpqrs = (i, k, l, j)
+		int chemist[8][4] = { { p, s, q, r }, { s, p, q, r }, { p, s, r, q },
+				{ s, p, r, q }, { q, r, p, s }, { r, q, p, s }, { q, r, s, p },
+				{ r, q, s, p } };
+		for (int x = 0; x < 8; x++) {
+			orbit[x][0] = chemist[x][0];
+			orbit[x][1] = chemist[x][2];
+			orbit[x][2] = chemist[x][3];
+			orbit[x][3] = chemist[x][1];
+		}
+	}
+
+public:
+
+	/**
+	 * Index of the unordered pair {i, j} in a packed triangle.
+	 */
+	static const std::size_t pairIndex(const std::size_t i,
+			const std::size_t j) {
+		return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+	}
+
+	FermionIntegrals(const int nSpinOrbitals) : n(nSpinOrbitals) {
+	}
+
+	/**
+	 * Add (overwrite) the coefficient of the term with the given
+	 * sites. Terms must be added before pack() is called.
+	 */
+	void setTerm(const std::vector<int>& sites, const double value) {
+		if (sites.empty()) {
+			eNuc = value;
+		} else if (sites.size() == 2) {
+			oneBodyTerms[denseIndex(sites[0], sites[1])] = value;
+		} else if (sites.size() == 4) {
+			twoBodyTerms[denseIndex(sites[0], sites[1], sites[2], sites[3])] =
+					value;
+		}
+	}
+
+	/**
+	 * Check the symmetries of the added terms and, if they
+	 * hold, move them into the packed arrays.
+	 */
+	void pack() {
+		if (n == 0) {
+			return;
+		}
+		for (auto& kv : oneBodyTerms) {
+			int p = kv.first / n, q = kv.first % n;
+			auto it = oneBodyTerms.find(denseIndex(q, p));
+			if (it == oneBodyTerms.end() || !equal(it->second, kv.second)) {
+				packed = false;
+				return;
+			}
+		}
+
+		int orbit[8][4];
+		for (auto& kv : twoBodyTerms) {
+			auto idx = kv.first;
+			int s = idx % n, r = (idx /= n) % n, q = (idx /= n) % n, p = idx / n;
+			if (p == q || r == s) {
+				if (kv.second != 0.0) {
+					packed = false;
+					return;
+				}
+				continue;
+			}
+			symmetryOrbit(p, q, r, s, orbit);
+			for (auto& o : orbit) {
+				if (o[0] != o[1] && o[2] != o[3]
+						&& !equal(twoBodyTerm(o[0], o[1], o[2], o[3]),
+								kv.second)) {
+					packed = false;
+					return;
+				}
+			}
+		}
+
+		std::size_t nPairs = pairIndex(n - 1, n - 1) + 1;
+		oneBody.assign(nPairs, 0.0);
+		twoBody.assign(pairIndex(nPairs - 1, nPairs - 1) + 1, 0.0);
+		for (auto& kv : oneBodyTerms) {
+			oneBody[pairIndex(kv.first / n, kv.first % n)] = kv.second;
+		}
+		for (auto& kv : twoBodyTerms) {
+			auto idx = kv.first;
+			int s = idx % n, r = (idx /= n) % n, q = (idx /= n) % n, p = idx / n;
+			if (p != q && r != s) {
+				twoBody[pairIndex(pairIndex(p, s), pairIndex(q, r))] = kv.second;
+			}
+		}
+		oneBodyTerms.clear();
+		twoBodyTerms.clear();
+		packed = true;
+	}
+
+	/**
+	 * Return true if the coefficients are stored in packed form.
+	 */
+	const bool isPacked() const {
+		return packed;
+	}
+
+	const int size() const {
+		return n;
+	}
+
+	const double E_nuc() const {
+		return eNuc;
+	}
+
+	const double hpq(const int p, const int q) const {
+		if (packed) {
+			return oneBody[pairIndex(p, q)];
+		}
+		auto it = oneBodyTerms.find(denseIndex(p, q));
+		return it == oneBodyTerms.end() ? 0.0 : it->second;
+	}
+
+	const double hpqrs(const int p, const int q, const int r,
+			const int s) const {
+		if (p == q || r == s) {
+			return packed ? 0.0 : twoBodyTerm(p, q, r, s);
+		}
+		if (packed) {
+			return twoBody[pairIndex(pairIndex(p, s), pairIndex(q, r))];
+		}
+		return twoBodyTerm(p, q, r, s);
+	}
+};
+
+}
+}
+
+#endif
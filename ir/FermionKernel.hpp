@@ -33,6 +33,7 @@
 
 #include "Function.hpp"
 #include "FermionInstruction.hpp"
+#include "FermionIntegrals.hpp"
 #include "XACC.hpp"
 #include "unsupported/Eigen/CXX11/Tensor"
 
@@ -57,6 +58,39 @@ protected:
 	 */
 	std::string _name;
 
+	/**
+	 * The coefficients of the instructions, built on demand
+	 */
+	std::shared_ptr<FermionIntegrals> integralStore;
+
+	/**
+	 * Set the coefficients of all instructions in the given store.
+	 */
+	virtual void addTerms(FermionIntegrals& store) {
+		for (auto& f : instructions) {
+			auto params = f->getParameters();
+			auto coeff = params[f->nParameters()-2].as<std::complex<double>>();
+			if (std::imag(coeff) != 0.0) {
+				xacc::error("FermionKernel::integrals requires real coefficients.");
+			}
+			store.setTerm(f->bits(), std::real(coeff));
+		}
+	}
+
+	/**
+	 * Return true if all instruction coefficients are real.
+	 */
+	virtual bool hasRealCoefficients() {
+		for (auto& f : instructions) {
+			auto params = f->getParameters();
+			auto coeff = params[f->nParameters()-2].as<std::complex<double>>();
+			if (std::imag(coeff) != 0.0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
 public:
 
 	/**
@@ -68,6 +102,13 @@ public:
 	FermionKernel(std::string kernelName) : _name(kernelName) {
 	}
 
+	/**
+	 * Return a copy of this kernel.
+	 */
+	virtual std::shared_ptr<FermionKernel> clone() {
+		return std::make_shared<FermionKernel>(*this);
+	}
+
 	/**
 	 * Return the number of FermionInstructions in this sum.
 	 *
@@ -122,6 +163,7 @@ public:
 	 * @param idx The index of the instruction to remove.
 	 */
 	void removeInstruction(const int idx) override {
+		integralStore.reset();
 		instructions.remove(getInstruction(idx));
 	}
 
@@ -132,6 +174,7 @@ public:
 	 * @param instruction
 	 */
 	void addInstruction(InstPtr instruction) override {
+		integralStore.reset();
 		instructions.push_back(instruction);
 	}
 
@@ -143,6 +186,7 @@ public:
 	 * @param replacingInst
 	 */
 	void replaceInstruction(const int idx, InstPtr replacingInst) override {
+		integralStore.reset();
 		std::replace(instructions.begin(), instructions.end(),
 				getInstruction(idx), replacingInst);
 	}
@@ -154,6 +198,7 @@ public:
 	 * @param newInst
 	 */
 	void insertInstruction(const int idx, InstPtr newInst) override {
+		integralStore.reset();
 		auto iter = std::next(instructions.begin(), idx);
 		instructions.insert(iter, newInst);
 	}
@@ -211,60 +256,84 @@ public:
 		return e;
 	}
 
+	/**
+	 * Return the real coefficients of this kernel as FermionIntegrals
+	 * over nQubits spin orbitals. They are built once and cached
+	 * until the instructions of this kernel change. Kernels with
+	 * imaginary coefficients are rejected with xacc::error.
+	 *
+	 * @param nQubits The number of spin orbitals
+	 * @return integrals The one and two body coefficients
+	 */
+	std::shared_ptr<const FermionIntegrals> integrals(const int nQubits) {
+		if (!integralStore || integralStore->size() != nQubits) {
+			auto store = std::make_shared<FermionIntegrals>(nQubits);
+			addTerms(*store);
+			store->pack();
+			integralStore = store;
+		}
+		return integralStore;
+	}
+
+	/**
+	 * Return a dense copy of the one body coefficients. Kernels with
+	 * imaginary coefficients, which integrals() rejects, are read
+	 * term by term instead.
+	 */
 	Eigen::Tensor<std::complex<double>, 2> hpq(const int nQubits) {
 		Eigen::Tensor<std::complex<double>, 2> hpq(nQubits, nQubits);
-		hpq.setZero();
-
-		auto instructions = getInstructions();
-		auto instVec = std::vector<InstPtr>(instructions.begin(), instructions.end());
-
-		// Loop over all Fermionic terms...
-		for (int z = 0; z < instructions.size(); ++z) {
-
-			auto f = instVec[z];
-
-			// Get the creation or annihilation sites
-			auto termSites = f->bits();
-			auto params = f->getParameters();
-			auto coeff = params[f->nParameters()-2].as<std::complex<double>>();
-
-			if (termSites.size() == 2) {
-				int p = termSites[0];
-				int q = termSites[1];
-				hpq(p,q) = coeff;
+		if (!hasRealCoefficients()) {
+			hpq.setZero();
+			for (auto& f : getInstructions()) {
+				auto termSites = f->bits();
+				auto params = f->getParameters();
+				if (termSites.size() == 2) {
+					hpq(termSites[0], termSites[1]) = params[f->nParameters()
+							- 2].as<std::complex<double>>();
+				}
 			}
+			return hpq;
 		}
 
+		auto h = integrals(nQubits);
+		for (int q = 0; q < nQubits; q++) {
+			for (int p = 0; p < nQubits; p++) {
+				hpq(p, q) = h->hpq(p, q);
+			}
+		}
 		return hpq;
 	}
 
+	/**
+	 * Return a dense copy of the two body coefficients. This takes
+	 * nQubits^4 complex values, consumers should prefer integrals().
+	 * Kernels with imaginary coefficients are read term by term.
+	 */
 	Eigen::Tensor<std::complex<double>, 4> hpqrs(const int nQubits) {
-
 		Eigen::Tensor<std::complex<double>, 4> hpqrs(nQubits, nQubits, nQubits, nQubits);
-		hpqrs.setZero();
-
-		auto instructions = getInstructions();
-		auto instVec = std::vector<InstPtr>(instructions.begin(), instructions.end());
-
-		// Loop over all Fermionic terms...
-		for (int z = 0; z < instructions.size(); ++z) {
-
-			auto f = instVec[z];
-
-			// Get the creation or annihilation sites
-			auto termSites = f->bits();
-			auto params = f->getParameters();
-			auto coeff = params[f->nParameters()-2].as<std::complex<double>>();
-
-			if (termSites.size() == 4) {
-				int p = termSites[0];
-				int q = termSites[1];
-				int r = termSites[2];
-				int s = termSites[3];
-				hpqrs(p,q,r,s) = coeff;
+		if (!hasRealCoefficients()) {
+			hpqrs.setZero();
+			for (auto& f : getInstructions()) {
+				auto termSites = f->bits();
+				auto params = f->getParameters();
+				if (termSites.size() == 4) {
+					hpqrs(termSites[0], termSites[1], termSites[2], termSites[3]) =
+							params[f->nParameters() - 2].as<std::complex<double>>();
+				}
 			}
+			return hpqrs;
 		}
 
+		auto h = integrals(nQubits);
+		for (int s = 0; s < nQubits; s++) {
+			for (int r = 0; r < nQubits; r++) {
+				for (int q = 0; q < nQubits; q++) {
+					for (int p = 0; p < nQubits; p++) {
+						hpqrs(p, q, r, s) = h->hpqrs(p, q, r, s);
+					}
+				}
+			}
+		}
 		return hpqrs;
 	}
 
@@ -0,0 +1,250 @@
+#ifndef IR_FERMIONOPERATOR_HPP_
+#define IR_FERMIONOPERATOR_HPP_
+
+#include "ColumnarFermionKernel.hpp"
+#include <complex>
+#include <unordered_map>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * FermionOperator is a sum of products of fermionic creation and
+ * annihilation operators, kept in normal order and merged by a hash
+ * of their operators, so duplicate terms (and terms that are equal
+ * after reordering) are stored once.
+ *
+ * Normal order puts creation operators left of annihilation
+ * operators, each group sorted by decreasing site. Reordering uses
+ * the anticommutation relations, so a term can expand into several
+ * normal ordered terms, and terms with a repeated creation or
+ * annihilation operator vanish.
+ *
+ * foldHermitian() pairs each term T with its hermitian conjugate when
+ * the conjugate carries the conjugate coefficient. Only T is kept and
+ * marked as folded, standing for T + T^dag. Spin mappings can then map
+ * half of those terms and add the hermitian conjugate of the result.
+ */
+class FermionOperator {
+
+public:
+
+	using Operators = std::vector<std::pair<int, int>>;
+
+	/**
+	 * A term's operators and variable.
+	 */
+	using Key = std::pair<Operators, std::string>;
+
+	struct KeyHash {
+		std::size_t operator()(const Key& k) const {
+			std::size_t h = std::hash<std::string>()(k.second);
+			for (auto& op : k.first) {
+				h = h * 31 + (2 * op.first + (op.second ? 1 : 0));
+			}
+			return h;
+		}
+	};
+
+	struct Term {
+		std::complex<double> coefficient;
+		bool folded;
+	};
+
+	using TermMap = std::unordered_map<Key, Term, KeyHash>;
+
+protected:
+
+	TermMap terms;
+
+	/**
+	 * Add coeff times the normal ordered form of ops.
+	 */
+	void addNormalOrdered(Operators ops, std::complex<double> coeff,
+			const std::string& var) {
+		for (int i = 1; i < ops.size(); i++) {
+			for (int j = i; j > 0; j--) {
+				auto right = ops[j], left = ops[j - 1];
+				if (right.second && !left.second) {
+					// a_p a^dag_q = delta_pq - a^dag_q a_p
+					std::swap(ops[j - 1], ops[j]);
+					coeff = -coeff;
+					if (right.first == left.first) {
+						Operators contracted(ops.begin(), ops.begin() + j - 1);
+						contracted.insert(contracted.end(), ops.begin() + j + 1,
+								ops.end());
+						addNormalOrdered(contracted, -coeff, var);
+					}
+				} else if (right.second == left.second) {
+					if (right.first == left.first) {
+						// a_p a_p = a^dag_p a^dag_p = 0
+						return;
+					} else if (right.first > left.first) {
+						std::swap(ops[j - 1], ops[j]);
+						coeff = -coeff;
+					}
+				}
+			}
+		}
+
+		auto it = terms.find(Key(ops, var));
+		if (it == terms.end()) {
+			terms.insert({Key(ops, var), Term {coeff, false}});
+		} else {
+			it->second.coefficient += coeff;
+		}
+	}
+
+public:
+
+	FermionOperator() {}
+
+	/**
+	 * Build the operator from all instructions of the given kernel.
+	 */
+	FermionOperator(FermionKernel& kernel) {
+		auto columnar = dynamic_cast<ColumnarFermionKernel*>(&kernel);
+		if (columnar) {
+			auto& columns = columnar->getColumns();
+			Operators ops;
+			for (int t = 0; t < columns.nTerms(); t++) {
+				ops.resize(columns.nOperators(t));
+				for (int i = 0; i < ops.size(); i++) {
+					ops[i] = {columns.termSites(t)[i], columns.termCreation(t)[i]};
+				}
+				addTerm(ops, columns.coefficient(t), columns.variable(t));
+			}
+		} else {
+			for (auto& inst : kernel.getInstructions()) {
+				auto sites = inst->bits();
+				auto params = inst->getParameters();
+				Operators ops;
+				for (int i = 0; i < sites.size(); i++) {
+					ops.push_back({sites[i], params[i].as<int>()});
+				}
+				addTerm(ops, params[params.size() - 2].as<std::complex<double>>(),
+						params[params.size() - 1].as<std::string>());
+			}
+		}
+	}
+
+	/**
+	 * Add coeff (times var) times the product of the given
+	 * (site, creation) operators.
+	 */
+	void addTerm(const Operators& ops, const std::complex<double> coeff,
+			const std::string& var = "") {
+		addNormalOrdered(ops, coeff, var);
+	}
+
+	FermionOperator& operator+=(const FermionOperator& other) {
+		for (auto& kv : other.terms) {
+			addTerm(kv.first.first, kv.second.coefficient, kv.first.second);
+		}
+		return *this;
+	}
+
+	const int nTerms() const {
+		return terms.size();
+	}
+
+	const TermMap& getTerms() const {
+		return terms;
+	}
+
+	/**
+	 * Remove all terms with coefficient magnitude below tol.
+	 */
+	void threshold(const double tol) {
+		for (auto it = terms.begin(); it != terms.end();) {
+			if (std::abs(it->second.coefficient) < tol) {
+				it = terms.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	/**
+	 * Return the normal ordered hermitian conjugate of the normal
+	 * ordered operators ops, multiplying sign by the sign of the
+	 * reordering.
+	 */
+	static Operators hermitianConjugate(const Operators& ops, int& sign) {
+		// (a^dag_p1 .. a^dag_pk a_q1 .. a_ql)^dag
+		//   = a^dag_ql .. a^dag_q1 a_pk .. a_p1,
+		// and reversing k operators takes k(k-1)/2 swaps
+		Operators conj;
+		int k = 0, l = 0;
+		for (auto it = ops.begin(); it != ops.end(); ++it) {
+			if (!it->second) {
+				conj.push_back({it->first, 1});
+				l++;
+			}
+		}
+		for (auto it = ops.begin(); it != ops.end(); ++it) {
+			if (it->second) {
+				conj.push_back({it->first, 0});
+				k++;
+			}
+		}
+		if ((k * (k - 1) / 2 + l * (l - 1) / 2) % 2) {
+			sign = -sign;
+		}
+		return conj;
+	}
+
+	/**
+	 * Fold hermitian conjugate pairs of terms without variables
+	 * (see class description).
+	 *
+	 * @param tol Tolerance when comparing conjugate coefficients
+	 * @return nFolded The number of folded pairs
+	 */
+	int foldHermitian(const double tol = 1e-12) {
+		int nFolded = 0;
+		for (auto it = terms.begin(); it != terms.end(); ++it) {
+			if (!it->first.second.empty() || it->second.folded) {
+				continue;
+			}
+			int sign = 1;
+			auto conj = hermitianConjugate(it->first.first, sign);
+			if (conj == it->first.first) {
+				continue;
+			}
+			auto other = terms.find(Key(conj, ""));
+			if (other == terms.end()) {
+				continue;
+			}
+			auto expected = std::conj(it->second.coefficient) * (double) sign;
+			if (std::abs(other->second.coefficient - expected)
+					<= tol * std::max(1.0, std::abs(expected))) {
+				it->second.folded = true;
+				terms.erase(other);
+				nFolded++;
+			}
+		}
+		return nFolded;
+	}
+
+	/**
+	 * Return a kernel with the terms of this operator that are
+	 * folded (folded = true) or not (folded = false).
+	 */
+	std::shared_ptr<ColumnarFermionKernel> toKernel(const std::string& name,
+			const bool folded = false) const {
+		FermionTermColumns columns;
+		for (auto& kv : terms) {
+			if (kv.second.folded == folded) {
+				columns.addTerm(kv.first.first.data(), kv.first.first.size(),
+						kv.second.coefficient, kv.first.second);
+			}
+		}
+		return std::make_shared<ColumnarFermionKernel>(name, std::move(columns));
+	}
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef IR_FERMIONTERMCOLUMNS_HPP_
+#define IR_FERMIONTERMCOLUMNS_HPP_
+
+#include "FermionInstruction.hpp"
+#include <complex>
+#include <unordered_map>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * FermionTermColumns stores a sum of fermion terms column-wise.
+ * The operators of all terms are kept in contiguous site and
+ * creation arrays, term t owning the entries offsets[t] to
+ * offsets[t+1]-1. Coefficients are kept in their own array and
+ * variable names are interned, each term storing the index of
+ * its variable (0 is the empty variable).
+ *
+ * Instructions are only created on request, either as new
+ * FermionInstructions or by refilling an existing one with load(),
+ * which does not allocate once the instruction's vectors are large
+ * enough.
+ */
+class FermionTermColumns {
+
+protected:
+
+	std::vector<int> sites;
+	std::vector<char> creation;
+	std::vector<std::size_t> offsets {0};
+	std::vector<std::complex<double>> coefficients;
+	std::vector<int> variableIds;
+
+	std::vector<std::string> variables {""};
+	std::unordered_map<std::string, int> variableIndex {{"", 0}};
+
+	const int intern(const std::string& var) {
+		auto it = variableIndex.find(var);
+		if (it != variableIndex.end()) {
+			return it->second;
+		}
+		variables.push_back(var);
+		variableIndex.insert({var, (int) variables.size() - 1});
+		return variables.size() - 1;
+	}
+
+public:
+
+	const int nTerms() const {
+		return coefficients.size();
+	}
+
+	const int nOperators(const int t) const {
+		return offsets[t + 1] - offsets[t];
+	}
+
+	/**
+	 * Pointer to the nOperators(t) sites of term t.
+	 */
+	const int* termSites(const int t) const {
+		return sites.data() + offsets[t];
+	}
+
+	/**
+	 * Pointer to the nOperators(t) creation flags of term t.
+	 */
+	const char* termCreation(const int t) const {
+		return creation.data() + offsets[t];
+	}
+
+	const std::complex<double>& coefficient(const int t) const {
+		return coefficients[t];
+	}
+
+	const std::string& variable(const int t) const {
+		return variables[variableIds[t]];
+	}
+
+	void reserve(const std::size_t nTerms, const std::size_t nOps) {
+		coefficients.reserve(nTerms);
+		variableIds.reserve(nTerms);
+		offsets.reserve(nTerms + 1);
+		sites.reserve(nOps);
+		creation.reserve(nOps);
+	}
+
+	void addTerm(const std::pair<int, int>* ops, const int nOps,
+			const std::complex<double> coeff, const std::string& var = "") {
+		for (int i = 0; i < nOps; i++) {
+			sites.push_back(ops[i].first);
+			creation.push_back(ops[i].second);
+		}
+		offsets.push_back(sites.size());
+		coefficients.push_back(coeff);
+		variableIds.push_back(intern(var));
+	}
+
+	/**
+	 * Insert the term described by the given fermion instruction
+	 * before term idx (idx = nTerms() appends).
+	 */
+	void insertTerm(const int idx, InstPtr inst) {
+		auto bits = inst->bits();
+		auto params = inst->getParameters();
+		auto n = params.size();
+
+		auto start = offsets[idx];
+		sites.insert(sites.begin() + start, bits.begin(), bits.end());
+		for (int i = 0; i < bits.size(); i++) {
+			creation.insert(creation.begin() + start + i,
+					(char) params[i].as<int>());
+		}
+		offsets.insert(offsets.begin() + idx + 1, start + bits.size());
+		for (int t = idx + 2; t < offsets.size(); t++) {
+			offsets[t] += bits.size();
+		}
+		coefficients.insert(coefficients.begin() + idx,
+				params[n - 2].as<std::complex<double>>());
+		variableIds.insert(variableIds.begin() + idx,
+				intern(params[n - 1].as<std::string>()));
+	}
+
+	void removeTerm(const int idx) {
+		auto start = offsets[idx], n = offsets[idx + 1] - start;
+		sites.erase(sites.begin() + start, sites.begin() + start + n);
+		creation.erase(creation.begin() + start, creation.begin() + start + n);
+		offsets.erase(offsets.begin() + idx + 1);
+		for (int t = idx + 1; t < offsets.size(); t++) {
+			offsets[t] -= n;
+		}
+		coefficients.erase(coefficients.begin() + idx);
+		variableIds.erase(variableIds.begin() + idx);
+	}
+
+	/**
+	 * Overwrite the given instruction with term t.
+	 */
+	void load(const int t, FermionInstruction& inst) const {
+		auto n = nOperators(t);
+		auto s = termSites(t);
+		auto c = termCreation(t);
+		inst.sites.assign(s, s + n);
+		inst.terms.resize(n);
+		inst.parameters.resize(n + 2);
+		for (int i = 0; i < n; i++) {
+			inst.terms[i] = {s[i], c[i]};
+			inst.parameters[i] = InstructionParameter((int) c[i]);
+		}
+		inst.parameters[n] = InstructionParameter(coefficients[t]);
+		inst.parameters[n + 1] = InstructionParameter(variable(t));
+	}
+
+	/**
+	 * Return term t as a new FermionInstruction.
+	 */
+	std::shared_ptr<FermionInstruction> instruction(const int t) const {
+		auto n = nOperators(t);
+		std::vector<std::pair<int, int>> ops(n);
+		for (int i = 0; i < n; i++) {
+			ops[i] = {termSites(t)[i], termCreation(t)[i]};
+		}
+		return std::make_shared<FermionInstruction>(ops, variable(t),
+				coefficients[t]);
+	}
+};
+
+}
+}
+
+#endif
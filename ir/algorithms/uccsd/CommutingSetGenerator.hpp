@@ -9,7 +9,8 @@
 #define VQE_TRANSFORMATION_COMMUTINGSETGENERATOR_HPP_
 
 #include "PauliOperator.hpp"
-#include <Eigen/Core>
+#include "BinaryPauliOperator.hpp"
+#include <algorithm>
 #include <numeric>
 
 using namespace xacc::quantum;
@@ -19,77 +20,119 @@ namespace xacc {
 namespace vqe {
 class CommutingSetGenerator {
 
-private:
-
-	std::pair<Eigen::VectorXi, Eigen::VectorXi> bv(Term& op, int nQubits) {
-		Eigen::VectorXi vx = Eigen::VectorXi::Zero(nQubits);
-		Eigen::VectorXi vz = Eigen::VectorXi::Zero(nQubits);
-
-		for (auto term : op.ops()) {
-			if (term.second == "X") {
-				vx(term.first) += 1;
-			} else if (term.second == "Z") {
-				vz(term.first) += 1;
-			} else if (term.second == "Y") {
-				vx(term.first) += 1;
-				vz(term.first) += 1;
-			}
-		}
-
-		return std::make_pair(vx, vz);
-	};
-
-	int bv_commutator(Term& term1, Term& term2, int nQubits) {
-			auto pair1 = bv(term1, nQubits);
-			auto pair2 = bv(term2, nQubits);
-			auto scalar = pair1.first.dot(pair2.second) + pair1.second.dot(pair2.first);
-			return scalar % 2;
-		};
-
 public:
 
+	/**
+	 * Partition the terms of the given operator into sets of mutually
+	 * commuting terms. Terms are placed greedily, in the order of the
+	 * operator's terms, into the first set whose members they all
+	 * commute with.
+	 *
+	 * Terms are converted to their bit-packed form once, so every
+	 * commutation check is a few word operations.
+	 *
+	 * @param composite The operator to partition
+	 * @param n_qubits The number of qubits of the operator
+	 * @return sets The commuting sets
+	 */
 	std::vector<std::vector<Term>> getCommutingSet(
 			PauliOperator& composite, int n_qubits) {
 
 		std::vector<std::vector<Term>> commuting_ops;
-		std::vector<Term> allTerms;
+		std::vector<std::vector<BinaryPauliTerm>> binarySets;
+
 		for (auto& kv : composite.getTerms()) {
-			allTerms.push_back(kv.second);
+			auto& t_i = kv.second;
+			BinaryPauliTerm b_i(t_i.ops());
+
+			bool placed = false;
+			for (int j = 0; j < binarySets.size(); j++) {
+				bool commutes = true;
+				for (auto& b_j : binarySets[j]) {
+					if (!b_i.commutes(b_j)) {
+						commutes = false;
+						break;
+					}
+				}
+
+				if (commutes) {
+					commuting_ops[j].push_back(t_i);
+					binarySets[j].push_back(b_i);
+					placed = true;
+					break;
+				}
+			}
+
+			if (!placed) {
+				commuting_ops.push_back({t_i});
+				binarySets.push_back({b_i});
+			}
 		}
 
-		for (int i = 0; i < allTerms.size(); i++) {
+		return commuting_ops;
+	}
 
-			auto t_i = allTerms[i];
+	/**
+	 * Partition the non-identity terms of the given operator into
+	 * qubit-wise commuting sets. Two terms commute qubit-wise if they
+	 * apply the same Pauli on every qubit they both act on, so every
+	 * term in a set can be measured after a single basis rotation.
+	 *
+	 * Terms are placed greedily, highest weight first, into the first
+	 * set they are compatible with.
+	 *
+	 * @param composite The operator to partition
+	 * @return sets The qubit-wise commuting sets
+	 */
+	std::vector<std::vector<Term>> getQubitWiseCommutingSet(
+			PauliOperator& composite) {
 
-			if (i == 0) {
-				commuting_ops.push_back({t_i});
-			} else {
-				auto comm_ticker = 0;
-				for (int j = 0; j < commuting_ops.size(); j++) {
-					auto j_op_list = commuting_ops[j];
-					int sum = 0;
-					int innerCounter = 0;
-					for (auto j_op : j_op_list) {
-						auto t_jopPtr = allTerms[innerCounter];
-						sum += bv_commutator(t_i, t_jopPtr,
-								n_qubits);
-						innerCounter++;
-					}
+		std::vector<Term> allTerms;
+		for (auto& kv : composite.getTerms()) {
+			if (!kv.second.isIdentity()) {
+				allTerms.push_back(kv.second);
+			}
+		}
 
-					if (sum == 0) {
-						commuting_ops[j].push_back(t_i);
-						comm_ticker += 1;
+		// Sort for a deterministic partitioning, since
+		// the terms are stored in an unordered map
+		std::sort(allTerms.begin(), allTerms.end(), [](Term& a, Term& b) {
+			if (a.ops().size() != b.ops().size()) {
+				return a.ops().size() > b.ops().size();
+			}
+			return a.id() < b.id();
+		});
+
+		std::vector<std::vector<Term>> sets;
+		std::vector<std::map<int, std::string>> bases;
+		for (auto& t : allTerms) {
+			auto ops = t.ops();
+			bool placed = false;
+			for (int j = 0; j < sets.size(); j++) {
+				bool compatible = true;
+				for (auto& op : ops) {
+					auto b = bases[j].find(op.first);
+					if (b != bases[j].end() && b->second != op.second) {
+						compatible = false;
 						break;
 					}
 				}
 
-				if (comm_ticker == 0) {
-					commuting_ops.push_back({t_i});
+				if (compatible) {
+					bases[j].insert(ops.begin(), ops.end());
+					sets[j].push_back(t);
+					placed = true;
+					break;
 				}
 			}
+
+			if (!placed) {
+				bases.push_back(ops);
+				sets.push_back({t});
+			}
 		}
 
-		return commuting_ops;
+		return sets;
 	}
 
 };
@@ -0,0 +1,272 @@
+#ifndef VQE_IR_PAULIEXPONENTIALCIRCUIT_HPP_
+#define VQE_IR_PAULIEXPONENTIALCIRCUIT_HPP_
+
+#include "IRProvider.hpp"
+#include "xacc_service.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace xacc {
+
+namespace vqe {
+
+/**
+ * A gate of a PauliExponentialCircuit, collected before any
+ * Instruction is created. Rotation angles are kept as a
+ * coefficient times an optional variable name, so rotations
+ * over the same variable can be fused.
+ */
+struct GateSpec {
+	std::string name;
+	std::vector<int> qubits;
+	bool isRotation = false;
+	double coefficient = 0.0;
+	std::string variable;
+
+	GateSpec(const std::string& n, const std::vector<int>& q) :
+			name(n), qubits(q) {
+	}
+
+	GateSpec(const std::string& n, const int q, const double c,
+			const std::string& var = "") :
+			name(n), qubits { q }, isRotation(true), coefficient(c), variable(
+					var) {
+	}
+};
+
+/**
+ * PauliExponentialCircuit is an append-only buffer of gates for a
+ * product of Pauli exponentials exp(-i theta/2 P). Every exponential
+ * is emitted as a basis change (H for X, Rx(pi/2) for Y), a CNOT
+ * ladder over the qubits of P, an Rz on the last qubit, and the
+ * inverse ladder and basis change.
+ *
+ * Consecutive exponentials that share qubits and bases leave inverse
+ * gate pairs behind, which optimize() removes. The buffer is turned
+ * into a Function only once, by toFunction().
+ */
+class PauliExponentialCircuit {
+
+public:
+
+	/**
+	 * A Pauli string as (qubit, 'X' | 'Y' | 'Z') pairs,
+	 * sorted by qubit.
+	 */
+	using PauliString = std::vector<std::pair<int, char>>;
+
+	/**
+	 * Gate count, CNOT count and depth of the circuit.
+	 */
+	struct Stats {
+		int nGates = 0;
+		int nCNOTs = 0;
+		int depth = 0;
+
+		const std::string toString() const {
+			std::stringstream ss;
+			ss << nGates << " gates, " << nCNOTs << " CNOTs, depth " << depth;
+			return ss.str();
+		}
+	};
+
+	PauliExponentialCircuit(const std::size_t capacity = 0) {
+		gates.reserve(capacity);
+	}
+
+	void addGate(const GateSpec& g) {
+		gates.push_back(g);
+	}
+
+	/**
+	 * Add exp(-i coefficient * variable / 2 P) for the Pauli string P.
+	 */
+	void addExponential(const PauliString& ops, const double coefficient,
+			const std::string& variable) {
+		auto pi = 3.14159265358979323;
+		int last = ops.size() - 1;
+
+		for (int i = last; i >= 0; i--) {
+			if (ops[i].second == 'X') {
+				gates.push_back(GateSpec("H", {ops[i].first}));
+			} else if (ops[i].second == 'Y') {
+				gates.push_back(GateSpec("Rx", ops[i].first, pi / 2.0));
+			}
+		}
+
+		for (int i = 0; i < last; i++) {
+			gates.push_back(GateSpec("CNOT", {ops[i].first, ops[i + 1].first}));
+		}
+
+		gates.push_back(GateSpec("Rz", ops[last].first, coefficient, variable));
+
+		for (int i = last - 1; i >= 0; i--) {
+			gates.push_back(GateSpec("CNOT", {ops[i].first, ops[i + 1].first}));
+		}
+
+		for (int i = last; i >= 0; i--) {
+			if (ops[i].second == 'X') {
+				gates.push_back(GateSpec("H", {ops[i].first}));
+			} else if (ops[i].second == 'Y') {
+				gates.push_back(GateSpec("Rx", ops[i].first, -1.0 * (pi / 2.0)));
+			}
+		}
+	}
+
+	/**
+	 * Return the order in which the given (mutually commuting) Pauli
+	 * exponentials should be emitted. Strings are sorted
+	 * lexicographically from the lowest qubit, so neighbours share
+	 * the longest possible prefix of basis changes and CNOTs.
+	 */
+	static std::vector<int> sharedPrefixOrder(
+			const std::vector<PauliString>& strings) {
+		std::vector<int> order(strings.size());
+		for (int i = 0; i < order.size(); i++) {
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+			return strings[a] < strings[b];
+		});
+		return order;
+	}
+
+	/**
+	 * Cancel adjacent inverse gate pairs (self-inverse gates on the
+	 * same qubits) and fuse adjacent rotations about the same axis
+	 * over the same variable, dropping rotations whose angle vanishes.
+	 * Gates are adjacent if no other gate acts on any of their qubits
+	 * in between, so cancellations cascade through CNOT ladders.
+	 *
+	 * @return nRemoved The number of removed gates
+	 */
+	int optimize() {
+		std::vector<GateSpec> out;
+		out.reserve(gates.size());
+		std::vector<bool> alive;
+		alive.reserve(gates.size());
+
+		// Indices (into out) of the live gates on every qubit
+		std::vector<std::vector<int>> wires;
+
+		auto remove = [&](const int j) {
+			for (auto q : out[j].qubits) {
+				wires[q].pop_back();
+			}
+			alive[j] = false;
+		};
+
+		for (auto& g : gates) {
+			for (auto q : g.qubits) {
+				if (q >= wires.size()) {
+					wires.resize(q + 1);
+				}
+			}
+
+			// The previous gate on all of g's qubits, if it is the same one
+			int j = wires[g.qubits[0]].empty() ? -1 : wires[g.qubits[0]].back();
+			if (j >= 0 && out[j].qubits == g.qubits
+					&& out[j].name == g.name) {
+				bool adjacent = true;
+				for (auto q : g.qubits) {
+					adjacent = adjacent && wires[q].back() == j;
+				}
+
+				if (adjacent && !g.isRotation && isSelfInverse(g.name)) {
+					remove(j);
+					continue;
+				}
+
+				if (adjacent && g.isRotation && out[j].variable == g.variable) {
+					out[j].coefficient += g.coefficient;
+					if (std::fabs(out[j].coefficient) < 1e-12) {
+						remove(j);
+					}
+					continue;
+				}
+			}
+
+			for (auto q : g.qubits) {
+				wires[q].push_back(out.size());
+			}
+			out.push_back(g);
+			alive.push_back(true);
+		}
+
+		int nRemoved = gates.size();
+		gates.clear();
+		for (int i = 0; i < out.size(); i++) {
+			if (alive[i]) {
+				gates.push_back(out[i]);
+			}
+		}
+		nRemoved -= gates.size();
+		return nRemoved;
+	}
+
+	Stats stats() const {
+		Stats s;
+		s.nGates = gates.size();
+		std::vector<int> levels;
+		for (auto& g : gates) {
+			if (g.name == "CNOT") {
+				s.nCNOTs++;
+			}
+			int level = 0;
+			for (auto q : g.qubits) {
+				if (q >= levels.size()) {
+					levels.resize(q + 1, 0);
+				}
+				level = std::max(level, levels[q]);
+			}
+			for (auto q : g.qubits) {
+				levels[q] = level + 1;
+			}
+			s.depth = std::max(s.depth, level + 1);
+		}
+		return s;
+	}
+
+	const std::vector<GateSpec>& getGates() const {
+		return gates;
+	}
+
+	/**
+	 * Materialize the buffer into a gate Function.
+	 */
+	std::shared_ptr<Function> toFunction(const std::string& name,
+			std::vector<InstructionParameter> variables) const {
+		auto gateRegistry = xacc::getService<IRProvider>("gate");
+		auto function = gateRegistry->createFunction(name, {}, variables);
+		for (auto& g : gates) {
+			auto inst = gateRegistry->createInstruction(g.name, g.qubits);
+			if (g.isRotation) {
+				if (g.variable.empty()) {
+					inst->setParameter(0, InstructionParameter(g.coefficient));
+				} else {
+					std::stringstream ss;
+					ss << g.coefficient << " * " << g.variable;
+					inst->setParameter(0, InstructionParameter(ss.str()));
+				}
+			}
+			function->addInstruction(inst);
+		}
+		return function;
+	}
+
+protected:
+
+	std::vector<GateSpec> gates;
+
+	static bool isSelfInverse(const std::string& name) {
+		return name == "H" || name == "X" || name == "Y" || name == "Z"
+				|| name == "CNOT" || name == "CZ" || name == "Swap";
+	}
+};
+
+}
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "GateFunction.hpp"
 #include "FermionToSpinTransformation.hpp"
 #include "CommutingSetGenerator.hpp"
+#include "PauliExponentialCircuit.hpp"
 // #include <boost/math/constants/constants.hpp>
 #include "xacc_service.hpp"
 
@@ -240,129 +241,73 @@ std::shared_ptr<Function> UCCSD::generate(
 //	auto resultsStr = compositeResult.toString();
 //	boost::replace_all(resultsStr, "+", "+\n");
 
-	// Create the Spin Hamiltonian
-	auto transformedIR = compositeResult.toXACCIR();
 	xacc::info("Done mapping UCCSD Fermion Operator to Spin.");
 
-	std::unordered_map<std::string, Term> terms = compositeResult.getTerms();
-
 	CommutingSetGenerator gen;
 	auto commutingSets = gen.getCommutingSet(compositeResult, nQubits);
-	auto pi = 3.14159265358979323; //boost::math::constants::pi<double>();
-	auto gateRegistry = xacc::getService<IRProvider>("gate");
-
-	auto uccsdGateFunction = gateRegistry->createFunction("uccsdPrep",{},
-			variables);
-
-
-	// Perform Trotterization...
-	for (auto s : commutingSets) {
-
-		for (auto inst : s) {
-			Term spinInst = inst;
-
-			// Get the individual pauli terms
-			auto termsMap = std::get<2>(spinInst);
-
-			std::vector<std::pair<int,std::string>> terms;
-			for (auto& kv : termsMap) {
+	auto optimizeCircuit = !xacc::optionExists("uccsd-no-optimize");
+
+	// Collect the Pauli strings of all terms first, so the gate
+	// buffer can be allocated once before emitting any gates
+	std::vector<std::vector<PauliExponentialCircuit::PauliString>> paulis;
+	std::vector<std::vector<Term*>> trotterTerms;
+	std::size_t nGates = nElectrons;
+	for (auto& s : commutingSets) {
+		paulis.emplace_back();
+		trotterTerms.emplace_back();
+		for (auto& inst : s) {
+			PauliExponentialCircuit::PauliString ops;
+			for (auto& kv : std::get<2>(inst)) {
 				if (kv.second != "I" && !kv.second.empty()) {
-					terms.push_back({kv.first, kv.second});
+					ops.push_back({kv.first, kv.second[0]});
 				}
 			}
-			// The largest qubit index is on the last term
-			int largestQbitIdx = terms[terms.size() - 1].first;
-			auto tempFunction = gateRegistry->createFunction("temp", {}, {});
-
-			for (int i = 0; i < terms.size(); i++) {
-
-				auto qbitIdx = terms[i].first;
-				auto gateName = terms[i].second;
-
-				if (i < terms.size() - 1) {
-					auto cnot =
-							gateRegistry->createInstruction(
-									"CNOT",
-									std::vector<int> { qbitIdx,
-											terms[i + 1].first });
-					tempFunction->addInstruction(cnot);
-				}
-
-				if (gateName == "X") {
-					auto hadamard =
-							gateRegistry->createInstruction(
-									"H", std::vector<int> { qbitIdx });
-					tempFunction->insertInstruction(0, hadamard);
-				} else if (gateName == "Y") {
-					auto rx =
-							gateRegistry->createInstruction(
-									"Rx", std::vector<int> { qbitIdx });
-					InstructionParameter p(pi / 2.0);
-					rx->setParameter(0, p);
-					tempFunction->insertInstruction(0, rx);
-				}
-
-				// Add the Rotation for the last term
-				if (i == terms.size() - 1) {
-					// FIXME DONT FORGET DIVIDE BY 2
-					std::stringstream ss;
-					ss << 2*std::imag(std::get<0>(spinInst)) << " * "
-							<< std::get<1>(spinInst);
-					auto rz =
-							gateRegistry->createInstruction(
-									"Rz", std::vector<int> { qbitIdx });
-
-					InstructionParameter p(ss.str());
-					rz->setParameter(0, p);
-					tempFunction->addInstruction(rz);
-
-				}
+			if (ops.empty()) {
+				continue;
 			}
+			nGates += 4 * ops.size() - 1;
+			paulis.back().push_back(std::move(ops));
+			trotterTerms.back().push_back(&inst);
+		}
+	}
 
-			int counter = tempFunction->nInstructions();
-			// Add the instruction on the backend of the circuit
-			for (int i = terms.size() - 1; i >= 0; i--) {
-
-				auto qbitIdx = terms[i].first;
-				auto gateName = terms[i].second;
-
-				if (i < terms.size() - 1) {
-					auto cnot =
-							gateRegistry->createInstruction(
-									"CNOT",
-									std::vector<int> { qbitIdx,
-											terms[i + 1].first });
-					tempFunction->insertInstruction(counter, cnot);
-					counter++;
-				}
+	PauliExponentialCircuit circuit(nGates);
 
-				if (gateName == "X") {
-					auto hadamard =
-							gateRegistry->createInstruction(
-									"H", std::vector<int> { qbitIdx });
-					tempFunction->addInstruction(hadamard);
-				} else if (gateName == "Y") {
-					auto rx =
-							gateRegistry->createInstruction(
-									"Rx", std::vector<int> { qbitIdx });
-					InstructionParameter p(-1.0 * (pi /2.0));
-					rx->setParameter(0, p);
-					tempFunction->addInstruction(rx);
-				}
+	// Prepare the Hartree-Fock reference state
+	for (int i = 0; i < nElectrons; i++) {
+		circuit.addGate(GateSpec("X", {i}));
+	}
 
-			}
-			// Add to the total UCCSD State Prep function
-			for (auto inst : tempFunction->getInstructions()) {
-				uccsdGateFunction->addInstruction(inst);
-			}
+	// Perform Trotterization. The terms of a commuting set can be
+	// applied in any order, so order them to share basis changes
+	// and CNOTs between neighbouring exponentials
+	for (int s = 0; s < paulis.size(); s++) {
+		std::vector<int> order(paulis[s].size());
+		for (int t = 0; t < order.size(); t++) {
+			order[t] = t;
+		}
+		if (optimizeCircuit) {
+			order = PauliExponentialCircuit::sharedPrefixOrder(paulis[s]);
+		}
+
+		for (auto t : order) {
+			auto& spinInst = *trotterTerms[s][t];
+			// FIXME DONT FORGET DIVIDE BY 2
+			circuit.addExponential(paulis[s][t],
+					2 * std::imag(std::get<0>(spinInst)), std::get<1>(spinInst));
 		}
 	}
 
-	for (int i = nElectrons-1; i >= 0; i--) {
-		auto xGate = gateRegistry->createInstruction(
-				"X", std::vector<int>{i});
-		uccsdGateFunction->insertInstruction(0,xGate);
+	unoptimizedStats = circuit.stats();
+	if (optimizeCircuit) {
+		circuit.optimize();
 	}
+	optimizedStats = circuit.stats();
+	xacc::info("UCCSD circuit: " + unoptimizedStats.toString()
+			+ ", optimized: " + optimizedStats.toString() + ".");
+
+	// Materialize the buffer into the UCCSD State Prep function
+	auto uccsdGateFunction = circuit.toFunction("uccsdPrep", variables);
 
 	return uccsdGateFunction;
 }
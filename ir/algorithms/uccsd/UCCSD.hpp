@@ -35,6 +35,7 @@
 #include "FermionKernel.hpp"
 #include "FermionIR.hpp"
 #include "PauliOperator.hpp"
+#include "PauliExponentialCircuit.hpp"
 
 namespace xacc {
 
@@ -73,6 +74,28 @@ public:
 	virtual const std::string description() const {
 		return "";
 	}
+
+	/**
+	 * Return the gate statistics of the last generated circuit
+	 * before the reordering and gate cancellation pass.
+	 */
+	const PauliExponentialCircuit::Stats& getUnoptimizedStats() const {
+		return unoptimizedStats;
+	}
+
+	/**
+	 * Return the gate statistics of the last generated circuit
+	 * (unless uccsd-no-optimize is set, after the reordering and
+	 * gate cancellation pass).
+	 */
+	const PauliExponentialCircuit::Stats& getOptimizedStats() const {
+		return optimizedStats;
+	}
+
+protected:
+
+	PauliExponentialCircuit::Stats unoptimizedStats;
+	PauliExponentialCircuit::Stats optimizedStats;
 };
 
 }
@@ -0,0 +1,88 @@
+
+/***********************************************************************************
+ * Copyright (c) 2016, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <gtest/gtest.h>
+#include "BinaryPauliOperator.hpp"
+
+using namespace xacc::vqe;
+
+TEST(BinaryPauliOperatorTester,checkTermProducts) {
+
+	std::complex<double> i(0,1);
+	BinaryPauliTerm x, y, z, result;
+	x.set(3, 'X');
+	y.set(3, 'Y');
+	z.set(3, 'Z');
+
+	// XY = iZ, YX = -iZ
+	EXPECT_EQ(1, x.multiply(y, result));
+	EXPECT_TRUE(result == z);
+	EXPECT_EQ(3, y.multiply(x, result));
+	EXPECT_TRUE(result == z);
+
+	// ZZ = I
+	EXPECT_EQ(0, z.multiply(z, result));
+	EXPECT_TRUE(result.isIdentity());
+
+	BinaryPauliTerm xx(std::map<int, std::string> { { 0, "X" }, { 100, "X" } });
+	BinaryPauliTerm zz(std::map<int, std::string> { { 0, "Z" }, { 100, "Z" } });
+	BinaryPauliTerm zi(std::map<int, std::string> { { 0, "Z" } });
+	EXPECT_TRUE(xx.commutes(zz));
+	EXPECT_FALSE(xx.commutes(zi));
+	EXPECT_EQ(2, xx.weight());
+	EXPECT_EQ("X", xx.toOps()[100]);
+}
+
+TEST(BinaryPauliOperatorTester,checkAgainstPauliOperator) {
+
+	std::complex<double> i(0,1);
+	PauliOperator a = PauliOperator({ { 0, "X" }, { 1, "Y" } }, 0.5)
+			+ PauliOperator({ { 1, "Z" }, { 2, "X" } }, -0.25 * i)
+			+ PauliOperator(1.5);
+	PauliOperator b = PauliOperator({ { 0, "Y" }, { 2, "Z" } }, 2.0)
+			+ PauliOperator({ { 1, "X" } }, 0.5 * i);
+
+	BinaryPauliOperator ba(a), bb(b);
+	auto product = (ba * bb).toPauliOperator();
+	auto sum = (ba + bb).toPauliOperator();
+
+	EXPECT_TRUE(product == a * b);
+	EXPECT_TRUE(sum == a + b);
+
+	// Cancellation drops the term
+	auto zero = (ba - ba).toPauliOperator();
+	EXPECT_EQ(0, zero.nTerms());
+}
+
+int main(int argc, char** argv) {
+   ::testing::InitGoogleTest(&argc, argv);
+   return RUN_ALL_TESTS();
+}
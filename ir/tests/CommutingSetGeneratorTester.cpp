@@ -72,6 +72,19 @@ TEST(CommutingSetGeneratorTester,checkCommutingSets) {
 	auto sets = gen.getCommutingSet(composite, 4);
 
 	std::cout << "SIZE: " << sets.size() << "\n";
+
+	// Every term is in exactly one set, and commutes
+	// with all other members of its set
+	int nTerms = 0;
+	for (auto& set : sets) {
+		for (auto& a : set) {
+			for (auto& b : set) {
+				EXPECT_TRUE(BinaryPauliTerm(a.ops()).commutes(BinaryPauliTerm(b.ops())));
+			}
+			nTerms++;
+		}
+	}
+	EXPECT_EQ(12, nTerms);
 //	EXPECT_TRUE(sets.size() == 2);
 //	EXPECT_TRUE(sets[0][0] == 0);
 //	EXPECT_TRUE(sets[0][1] == 2);
@@ -90,6 +103,41 @@ TEST(CommutingSetGeneratorTester,checkCommutingSets) {
 
 }
 
+TEST(CommutingSetGeneratorTester,checkQubitWiseCommutingSets) {
+
+	PauliOperator composite = PauliOperator(std::map<int, std::string> { { 0, "Z" } })
+			+ PauliOperator(std::map<int, std::string> { { 1, "Z" } })
+			+ PauliOperator(std::map<int, std::string> { { 0, "Z" }, { 1, "Z" } })
+			+ PauliOperator(std::map<int, std::string> { { 0, "X" }, { 1, "X" } })
+			+ PauliOperator(std::map<int, std::string> { { 0, "Y" }, { 1, "Y" } })
+			+ PauliOperator(std::map<int, std::string> { { 2, "X" } })
+			+ PauliOperator(1.0);
+
+	CommutingSetGenerator gen;
+	auto sets = gen.getQubitWiseCommutingSet(composite);
+
+	// ZZ, Z0 and Z1 share a set, X2 joins the first
+	// compatible set, XX and YY each need their own
+	EXPECT_EQ(3, sets.size());
+
+	int nTerms = 0;
+	for (auto& set : sets) {
+		std::map<int, std::string> basis;
+		for (auto& t : set) {
+			for (auto& op : t.ops()) {
+				auto b = basis.find(op.first);
+				if (b != basis.end()) {
+					EXPECT_EQ(b->second, op.second);
+				}
+				basis[op.first] = op.second;
+			}
+			nTerms++;
+		}
+	}
+
+	// The identity term is not part of any set
+	EXPECT_EQ(6, nTerms);
+}
 
 int main(int argc, char** argv) {
    ::testing::InitGoogleTest(&argc, argv);
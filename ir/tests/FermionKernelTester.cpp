@@ -31,6 +31,8 @@
  **********************************************************************************/
 #include <gtest/gtest.h>
 #include "FermionKernel.hpp"
+#include "ColumnarFermionKernel.hpp"
+#include "FermionOperator.hpp"
 
 using namespace xacc::vqe;
 
@@ -61,6 +63,197 @@ TEST(FermionKernelTester,checkFermionKernelConstruction) {
 
 }
 
+TEST(FermionKernelTester,checkIntegrals) {
+
+	// H2 / sto-3g as (coefficient, sites) of
+	// a^dag_p a_q and a^dag_p a^dag_q a_r a_s terms
+	std::vector<std::pair<double, std::vector<int>>> terms {
+			{ 0.7137758743754461, { } }, { -1.252477303982147, { 0, 0 } },
+			{ 0.337246551663004, { 0, 1, 1, 0 } }, { 0.0906437679061661, { 0, 1, 3, 2 } },
+			{ 0.0906437679061661, { 0, 2, 0, 2 } }, { 0.3317360224302783, { 0, 2, 2, 0 } },
+			{ 0.0906437679061661, { 0, 3, 1, 2 } }, { 0.3317360224302783, { 0, 3, 3, 0 } },
+			{ 0.337246551663004, { 1, 0, 0, 1 } }, { 0.0906437679061661, { 1, 0, 2, 3 } },
+			{ -1.252477303982147, { 1, 1 } }, { 0.0906437679061661, { 1, 2, 0, 3 } },
+			{ 0.3317360224302783, { 1, 2, 2, 1 } }, { 0.0906437679061661, { 1, 3, 1, 3 } },
+			{ 0.3317360224302783, { 1, 3, 3, 1 } }, { 0.3317360224302783, { 2, 0, 0, 2 } },
+			{ 0.0906437679061661, { 2, 0, 2, 0 } }, { 0.3317360224302783, { 2, 1, 1, 2 } },
+			{ 0.0906437679061661, { 2, 1, 3, 0 } }, { -0.4759344611440753, { 2, 2 } },
+			{ 0.0906437679061661, { 2, 3, 1, 0 } }, { 0.3486989747346679, { 2, 3, 3, 2 } },
+			{ 0.3317360224302783, { 3, 0, 0, 3 } }, { 0.0906437679061661, { 3, 0, 2, 1 } },
+			{ 0.3317360224302783, { 3, 1, 1, 3 } }, { 0.0906437679061661, { 3, 1, 3, 1 } },
+			{ 0.0906437679061661, { 3, 2, 0, 1 } }, { 0.3486989747346679, { 3, 2, 2, 3 } },
+			{ -0.4759344611440753, { 3, 3 } } };
+
+	FermionKernel kernel("h2");
+	for (auto& t : terms) {
+		std::vector<std::pair<int, int>> ops;
+		for (int i = 0; i < t.second.size(); i++) {
+			ops.push_back({t.second[i], i < t.second.size() / 2 ? 1 : 0});
+		}
+		kernel.addInstruction(std::make_shared<FermionInstruction>(ops, t.first));
+	}
+
+	auto integrals = kernel.integrals(4);
+	EXPECT_TRUE(integrals->isPacked());
+	EXPECT_TRUE(integrals == kernel.integrals(4));
+	EXPECT_NEAR(0.7137758743754461, integrals->E_nuc(), 1e-12);
+
+	// Every stored term is returned, everything else is zero
+	auto hpq = kernel.hpq(4);
+	auto hpqrs = kernel.hpqrs(4);
+	int nonZero = 0;
+	for (int p = 0; p < 4; p++) {
+		for (int q = 0; q < 4; q++) {
+			nonZero += std::abs(hpq(p, q)) > 0.0;
+			for (int r = 0; r < 4; r++) {
+				for (int s = 0; s < 4; s++) {
+					nonZero += std::abs(hpqrs(p, q, r, s)) > 0.0;
+				}
+			}
+		}
+	}
+	EXPECT_EQ(28, nonZero);
+	for (auto& t : terms) {
+		auto& v = t.second;
+		if (v.size() == 2) {
+			EXPECT_EQ(t.first, integrals->hpq(v[0], v[1]));
+		} else if (v.size() == 4) {
+			EXPECT_EQ(t.first, integrals->hpqrs(v[0], v[1], v[2], v[3]));
+		}
+	}
+
+	// Breaking the symmetry falls back to unpacked storage
+	kernel.addInstruction(std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 0, 1 }, { 2, 1 }, { 1, 0 }, {
+					3, 0 } }, 0.5));
+	integrals = kernel.integrals(4);
+	EXPECT_FALSE(integrals->isPacked());
+	EXPECT_EQ(0.5, integrals->hpqrs(0, 2, 1, 3));
+	EXPECT_EQ(0.0, integrals->hpqrs(3, 1, 2, 0));
+	EXPECT_EQ(0.337246551663004, integrals->hpqrs(0, 1, 1, 0));
+}
+
+TEST(FermionKernelTester,checkColumnarKernel) {
+
+	std::vector<InstPtr> insts {
+		std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 0, 1 }, { 1, 0 } }, 0.5),
+		std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 1, 1 }, { 0, 0 } }, 0.5),
+		std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 3, 1 }, { 2, 1 }, { 1, 0 }, {
+					0, 0 } }, "theta", 2.0),
+		std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { }, 0.7) };
+
+	FermionKernel kernel("foo");
+	ColumnarFermionKernel columnar("foo");
+	for (auto& i : insts) {
+		kernel.addInstruction(i);
+		columnar.addInstruction(i);
+	}
+
+	auto& columns = columnar.getColumns();
+	EXPECT_EQ(4, columnar.nInstructions());
+	EXPECT_EQ(4, columns.nOperators(2));
+	EXPECT_EQ(3, columns.termSites(2)[0]);
+	EXPECT_EQ("theta", columns.variable(2));
+	EXPECT_EQ(columns.variable(0), columns.variable(3));
+	EXPECT_EQ(kernel.toString(""), columnar.toString(""));
+
+	for (int i = 0; i < insts.size(); i++) {
+		auto inst = columnar.getInstruction(i);
+		EXPECT_TRUE(insts[i]->bits() == inst->bits());
+		EXPECT_EQ(insts[i]->toString(""), inst->toString(""));
+	}
+
+	columnar.removeInstruction(1);
+	columnar.insertInstruction(0, insts[1]);
+	EXPECT_EQ(4, columnar.nInstructions());
+	EXPECT_TRUE(insts[1]->bits() == columnar.getInstruction(0)->bits());
+	EXPECT_TRUE(insts[0]->bits() == columnar.getInstruction(1)->bits());
+	EXPECT_EQ("theta", columns.variable(2));
+	EXPECT_EQ(0.7, columnar.integrals(4)->E_nuc());
+	EXPECT_EQ(0.5, columnar.integrals(4)->hpq(1, 0));
+}
+
+TEST(FermionKernelTester,checkComplexCoefficients) {
+
+	// integrals() only holds real coefficients, the dense
+	// accessors must still return imaginary ones
+	std::complex<double> a(0.5, 0.25), b(0.0, -0.125);
+	std::vector<InstPtr> insts {
+		std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 0, 1 }, { 1, 0 } }, a),
+		std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 1, 1 }, { 0, 0 } }, std::conj(a)),
+		std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 3, 1 }, { 2, 1 }, { 1, 0 }, {
+					0, 0 } }, b) };
+
+	FermionKernel kernel("foo");
+	ColumnarFermionKernel columnar("foo");
+	for (auto& i : insts) {
+		kernel.addInstruction(i);
+		columnar.addInstruction(i);
+	}
+
+	for (FermionKernel* k : std::vector<FermionKernel*> { &kernel, &columnar }) {
+		auto hpq = k->hpq(4);
+		auto hpqrs = k->hpqrs(4);
+		EXPECT_EQ(a, hpq(0, 1));
+		EXPECT_EQ(std::conj(a), hpq(1, 0));
+		EXPECT_EQ(std::complex<double>(0.0), hpq(0, 0));
+		EXPECT_EQ(b, hpqrs(3, 2, 1, 0));
+		EXPECT_EQ(std::complex<double>(0.0), hpqrs(0, 1, 2, 3));
+	}
+}
+
+TEST(FermionKernelTester,checkFermionOperator) {
+
+	FermionOperator op;
+
+	// a_0 a^dag_0 = 1 - a^dag_0 a_0
+	op.addTerm({ { 0, 0 }, { 0, 1 } }, 2.0);
+	EXPECT_EQ(2, op.nTerms());
+	auto& terms = op.getTerms();
+	EXPECT_EQ(std::complex<double>(2.0),
+			terms.at( { { }, "" }).coefficient);
+	EXPECT_EQ(std::complex<double>(-2.0),
+			terms.at( { { { 0, 1 }, { 0, 0 } }, "" }).coefficient);
+
+	// a^dag_0 a^dag_1 = -a^dag_1 a^dag_0, and duplicates are merged
+	op.addTerm({ { 0, 1 }, { 1, 1 } }, 1.5);
+	op.addTerm({ { 1, 1 }, { 0, 1 } }, 0.5);
+	EXPECT_EQ(3, op.nTerms());
+	EXPECT_EQ(std::complex<double>(-1.0),
+			terms.at( { { { 1, 1 }, { 0, 1 } }, "" }).coefficient);
+
+	// a^dag_0 a^dag_0 = 0, and cancelling terms are removed by threshold
+	op.addTerm({ { 0, 1 }, { 0, 1 } }, 1.0);
+	op.addTerm({ { 1, 1 }, { 0, 1 } }, 1.0);
+	EXPECT_EQ(3, op.nTerms());
+	op.threshold(1e-12);
+	EXPECT_EQ(2, op.nTerms());
+
+	// Terms with variables are kept apart
+	op.addTerm({ { 2, 1 }, { 0, 0 } }, 1.0, "theta");
+	EXPECT_EQ(3, op.nTerms());
+
+	op.addTerm({ { 2, 1 }, { 0, 0 } }, 3.17);
+	op.addTerm({ { 0, 1 }, { 2, 0 } }, 3.17);
+	op.addTerm({ { 3, 1 }, { 1, 1 }, { 2, 0 }, { 0, 0 } }, 0.25);
+	op.addTerm({ { 0, 1 }, { 2, 1 }, { 1, 0 }, { 3, 0 } }, 0.25);
+	EXPECT_EQ(7, op.nTerms());
+	EXPECT_EQ(2, op.foldHermitian());
+	EXPECT_EQ(5, op.nTerms());
+
+	auto folded = op.toKernel("folded", true);
+	auto plain = op.toKernel("plain");
+	EXPECT_EQ(2, folded->nInstructions());
+	EXPECT_EQ(3, plain->nInstructions());
+}
+
 int main(int argc, char** argv) {
    ::testing::InitGoogleTest(&argc, argv);
    return RUN_ALL_TESTS();
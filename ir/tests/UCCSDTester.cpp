@@ -31,6 +31,7 @@
 #include <gtest/gtest.h>
 #include "UCCSD.hpp"
 #include "Instruction.hpp"
+#include "PauliExponentialCircuit.hpp"
 
 using namespace xacc;
 using namespace xacc::vqe;
@@ -45,9 +46,50 @@ TEST(UCCSDTester,checkUCCSD) {
 	auto f = statePrepGen.generate(buffer, {InstructionParameter(2), InstructionParameter(4)});
 
 	std::cout << f->toString("qreg") << "\n";
+
+	// The Hartree-Fock reference state comes first
+	EXPECT_EQ("X", f->getInstruction(0)->name());
+	EXPECT_EQ("X", f->getInstruction(1)->name());
+
+	// The optimization pass never makes the circuit larger
+	auto before = statePrepGen.getUnoptimizedStats();
+	auto after = statePrepGen.getOptimizedStats();
+	EXPECT_EQ(after.nGates, f->nInstructions());
+	EXPECT_LE(after.nGates, before.nGates);
+	EXPECT_LE(after.nCNOTs, before.nCNOTs);
+	EXPECT_LE(after.depth, before.depth);
 	xacc::Finalize();
 }
 
+TEST(UCCSDTester,checkPauliExponentialCircuit) {
+
+	PauliExponentialCircuit circuit;
+	circuit.addExponential({{0, 'X'}, {1, 'X'}}, 1.0, "t0");
+	circuit.addExponential({{0, 'X'}, {1, 'X'}}, 2.0, "t0");
+	circuit.addExponential({{0, 'Y'}, {1, 'X'}, {2, 'Z'}}, 0.5, "t1");
+
+	auto before = circuit.stats();
+	EXPECT_EQ(23, before.nGates);
+	EXPECT_EQ(8, before.nCNOTs);
+
+	// The first two exponentials fuse into one with angle 3 t0,
+	// and the H on qubit 1 cancels against the third one
+	EXPECT_EQ(9, circuit.optimize());
+	auto after = circuit.stats();
+	EXPECT_EQ(14, after.nGates);
+	EXPECT_EQ(6, after.nCNOTs);
+	EXPECT_EQ(12, after.depth);
+
+	auto& gates = circuit.getGates();
+	EXPECT_EQ("Rz", gates[3].name);
+	EXPECT_NEAR(3.0, gates[3].coefficient, 1e-12);
+	EXPECT_EQ("t0", gates[3].variable);
+
+	// Neighbours in the shared prefix order share the longest prefix
+	auto order = PauliExponentialCircuit::sharedPrefixOrder({{{0, 'Y'}, {1, 'X'}},
+			{{0, 'X'}, {2, 'Y'}}, {{0, 'X'}, {1, 'X'}}});
+	EXPECT_EQ(std::vector<int>({2, 1, 0}), order);
+}
 
 int main(int argc, char** argv) {
    ::testing::InitGoogleTest(&argc, argv);
@@ -2,9 +2,32 @@
 #define MPI_MPIPROVIDER_HPP_
 
 #include "Identifiable.hpp"
+#include <functional>
 
 namespace xacc {
 namespace vqe {
+
+/**
+ * Handle to a non-blocking collective. The buffers passed
+ * to the collective must stay alive and unmodified until
+ * wait() returns or test() returns true.
+ */
+class CommunicatorRequest {
+public:
+	virtual void wait() = 0;
+	virtual bool test() = 0;
+	virtual ~CommunicatorRequest() {}
+};
+
+/**
+ * Request for a collective that completed immediately.
+ */
+class CompletedRequest : public CommunicatorRequest {
+public:
+	virtual void wait() {}
+	virtual bool test() { return true; }
+};
+
 class Communicator {
 public:
 
@@ -21,6 +44,45 @@ public:
 	virtual void sumInts(int& myVal, int& result) = 0;
 	virtual void maxDouble(double& myVal, double& result) = 0;
 
+	/**
+	 * Gather every rank's string into result, on all ranks.
+	 */
+	virtual void allGather(std::string& myVal, std::vector<std::string>& result) = 0;
+
+	/**
+	 * Element-wise sum of every rank's vector into result, on all ranks.
+	 */
+	virtual void sumDoubles(std::vector<double>& myVals, std::vector<double>& result) = 0;
+
+	/**
+	 * Concatenate every rank's (variable length) vector into result
+	 * on the root rank, in rank order. counts holds the length
+	 * contributed by each rank.
+	 */
+	virtual void gatherv(std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts, const int root) = 0;
+	virtual void gatherv(std::vector<char>& myVals, std::vector<char>& result,
+			std::vector<int>& counts, const int root) = 0;
+
+	/**
+	 * As gatherv, but the result is available on all ranks.
+	 */
+	virtual void allGatherv(std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts) = 0;
+	virtual void allGatherv(std::vector<char>& myVals, std::vector<char>& result,
+			std::vector<int>& counts) = 0;
+
+	/**
+	 * Non-blocking versions of sumDoubles and allGatherv, result
+	 * is valid once the returned request has completed. The counts
+	 * of iAllGatherv are exchanged before it returns.
+	 */
+	virtual std::shared_ptr<CommunicatorRequest> iSumDoubles(
+			std::vector<double>& myVals, std::vector<double>& result) = 0;
+	virtual std::shared_ptr<CommunicatorRequest> iAllGatherv(
+			std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts) = 0;
+
 	virtual ~Communicator() {}
 
 };
@@ -33,6 +95,16 @@ public:
 
 	virtual std::shared_ptr<Communicator> getCommunicator() = 0;
 
+	/**
+	 * Run f as the program of every rank of this process. Process
+	 * based providers have one rank per process, so f is called once
+	 * with getCommunicator(). Thread based providers call f on every
+	 * rank's thread with that rank's Communicator.
+	 */
+	virtual void run(std::function<void(std::shared_ptr<Communicator>)> f) {
+		f(getCommunicator());
+	}
+
 	virtual ~MPIProvider() {}
 
 };
@@ -8,10 +8,82 @@
 namespace xacc {
 namespace vqe {
 
+/**
+ * Wraps the MPI_Request of a non-blocking MPI collective.
+ */
+class BoostMPIRequest : public CommunicatorRequest {
+protected:
+	MPI_Request request;
+	bool done = false;
+	// Displacements that must outlive the request
+	std::vector<int> displs;
+public:
+	BoostMPIRequest(MPI_Request r, std::vector<int> d = {}) :
+			request(r), displs(d) {}
+
+	virtual void wait() {
+		if (!done) {
+			MPI_Wait(&request, MPI_STATUS_IGNORE);
+			done = true;
+		}
+	}
+
+	virtual bool test() {
+		if (!done) {
+			int flag = 0;
+			MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+			done = flag;
+		}
+		return done;
+	}
+
+	MPI_Request* handle() {
+		return &request;
+	}
+
+	int* displacements() {
+		return displs.data();
+	}
+
+	virtual ~BoostMPIRequest() {
+		wait();
+	}
+};
+
 class BoostCommunicator : public Communicator {
 
 protected:
 	boost::mpi::communicator comm;
+
+	// Exchange the counts and compute the displacements
+	// of a gatherv, resizing result to the total length
+	template<typename T>
+	std::vector<int> prepareGatherv(std::vector<T>& myVals,
+			std::vector<T>& result, std::vector<int>& counts) {
+		int myCount = myVals.size();
+		boost::mpi::all_gather(comm, myCount, counts);
+		std::vector<int> displs(counts.size(), 0);
+		for (int i = 1; i < counts.size(); i++) {
+			displs[i] = displs[i - 1] + counts[i - 1];
+		}
+		result.resize(displs.back() + counts.back());
+		return displs;
+	}
+
+	template<typename T>
+	void gathervImpl(std::vector<T>& myVals, std::vector<T>& result,
+			std::vector<int>& counts, const int root) {
+		auto displs = prepareGatherv(myVals, result, counts);
+		auto type = boost::mpi::get_mpi_datatype<T>();
+		if (root < 0) {
+			MPI_Allgatherv(myVals.data(), myVals.size(), type, result.data(),
+					counts.data(), displs.data(), type, MPI_Comm(comm));
+		} else {
+			MPI_Gatherv(myVals.data(), myVals.size(), type, result.data(),
+					counts.data(), displs.data(), type, root, MPI_Comm(comm));
+		}
+	}
+
 public:
 
 	BoostCommunicator(boost::mpi::communicator& c) :comm(c) {}
@@ -44,6 +116,56 @@ public:
 		boost::mpi::all_reduce(comm, myVal, result, boost::mpi::maximum<double>());
 	}
 
+	virtual void allGather(std::string& myVal, std::vector<std::string>& result) {
+		boost::mpi::all_gather(comm, myVal, result);
+	}
+
+	virtual void sumDoubles(std::vector<double>& myVals, std::vector<double>& result) {
+		result.resize(myVals.size());
+		boost::mpi::all_reduce(comm, myVals.data(), myVals.size(), result.data(),
+				std::plus<double>());
+	}
+
+	virtual void gatherv(std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts, const int root) {
+		gathervImpl(myVals, result, counts, root);
+	}
+
+	virtual void gatherv(std::vector<char>& myVals, std::vector<char>& result,
+			std::vector<int>& counts, const int root) {
+		gathervImpl(myVals, result, counts, root);
+	}
+
+	virtual void allGatherv(std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts) {
+		gathervImpl(myVals, result, counts, -1);
+	}
+
+	virtual void allGatherv(std::vector<char>& myVals, std::vector<char>& result,
+			std::vector<int>& counts) {
+		gathervImpl(myVals, result, counts, -1);
+	}
+
+	virtual std::shared_ptr<CommunicatorRequest> iSumDoubles(
+			std::vector<double>& myVals, std::vector<double>& result) {
+		result.resize(myVals.size());
+		auto request = std::make_shared<BoostMPIRequest>(MPI_REQUEST_NULL);
+		MPI_Iallreduce(myVals.data(), result.data(), myVals.size(), MPI_DOUBLE,
+				MPI_SUM, MPI_Comm(comm), request->handle());
+		return request;
+	}
+
+	virtual std::shared_ptr<CommunicatorRequest> iAllGatherv(
+			std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts) {
+		auto displs = prepareGatherv(myVals, result, counts);
+		auto request = std::make_shared<BoostMPIRequest>(MPI_REQUEST_NULL, displs);
+		MPI_Iallgatherv(myVals.data(), myVals.size(), MPI_DOUBLE, result.data(),
+				counts.data(), request->displacements(), MPI_DOUBLE,
+				MPI_Comm(comm), request->handle());
+		return request;
+	}
+
 	virtual ~BoostCommunicator() {}
 
 };
@@ -40,6 +40,49 @@ public:
 		result = myVal;
 	}
 
+	virtual void allGather(std::string& myVal, std::vector<std::string>& result) {
+		result = {myVal};
+	}
+
+	virtual void sumDoubles(std::vector<double>& myVals, std::vector<double>& result) {
+		result = myVals;
+	}
+
+	virtual void gatherv(std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts, const int root) {
+		allGatherv(myVals, result, counts);
+	}
+
+	virtual void gatherv(std::vector<char>& myVals, std::vector<char>& result,
+			std::vector<int>& counts, const int root) {
+		allGatherv(myVals, result, counts);
+	}
+
+	virtual void allGatherv(std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts) {
+		result = myVals;
+		counts = {(int) myVals.size()};
+	}
+
+	virtual void allGatherv(std::vector<char>& myVals, std::vector<char>& result,
+			std::vector<int>& counts) {
+		result = myVals;
+		counts = {(int) myVals.size()};
+	}
+
+	virtual std::shared_ptr<CommunicatorRequest> iSumDoubles(
+			std::vector<double>& myVals, std::vector<double>& result) {
+		sumDoubles(myVals, result);
+		return std::make_shared<CompletedRequest>();
+	}
+
+	virtual std::shared_ptr<CommunicatorRequest> iAllGatherv(
+			std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts) {
+		allGatherv(myVals, result, counts);
+		return std::make_shared<CompletedRequest>();
+	}
+
 	virtual ~NullCommunicator() {}
 
 };
@@ -0,0 +1,117 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <gtest/gtest.h>
+#include "NoMPIProvider.hpp"
+
+using namespace xacc::vqe;
+
+TEST(NoMPIProviderTester,checkReductions) {
+
+	NoMPIProvider provider;
+	provider.initialize();
+	auto comm = provider.getCommunicator();
+
+	EXPECT_EQ(0, comm->rank());
+	EXPECT_EQ(1, comm->size());
+
+	// With a single rank every reduction is the identity
+	double d = 2.5, dSum = 0.0, dMax = 0.0;
+	comm->sumDoubles(d, dSum);
+	comm->maxDouble(d, dMax);
+	EXPECT_EQ(2.5, dSum);
+	EXPECT_EQ(2.5, dMax);
+
+	int i = 3, iSum = 0;
+	comm->sumInts(i, iSum);
+	EXPECT_EQ(3, iSum);
+
+	std::vector<double> vals {1.0, -2.0, 3.5}, sum;
+	comm->sumDoubles(vals, sum);
+	EXPECT_EQ(vals, sum);
+
+	std::string s = "rank0";
+	std::vector<std::string> all;
+	comm->allGather(s, all);
+	EXPECT_EQ(std::vector<std::string>{"rank0"}, all);
+
+	std::vector<double> b {4.0};
+	comm->broadcast(b, 0);
+	EXPECT_EQ(std::vector<double>{4.0}, b);
+}
+
+TEST(NoMPIProviderTester,checkGatherv) {
+
+	NoMPIProvider provider;
+	provider.initialize();
+	auto comm = provider.getCommunicator();
+
+	// The result holds this rank's values, counts its length
+	std::vector<double> vals {1.0, 2.0, 3.0}, result;
+	std::vector<int> counts;
+	comm->gatherv(vals, result, counts, 0);
+	EXPECT_EQ(vals, result);
+	EXPECT_EQ(std::vector<int>{3}, counts);
+
+	std::vector<char> bytes {'a', 'b'}, byteResult;
+	comm->allGatherv(bytes, byteResult, counts);
+	EXPECT_EQ(bytes, byteResult);
+	EXPECT_EQ(std::vector<int>{2}, counts);
+
+	std::vector<double> empty;
+	comm->allGatherv(empty, result, counts);
+	EXPECT_TRUE(result.empty());
+	EXPECT_EQ(std::vector<int>{0}, counts);
+}
+
+TEST(NoMPIProviderTester,checkCompletedRequests) {
+
+	NoMPIProvider provider;
+	provider.initialize();
+	auto comm = provider.getCommunicator();
+
+	// Non-blocking collectives complete before they return
+	std::vector<double> vals {1.0, 2.0}, sum, gathered;
+	std::vector<int> counts;
+	auto r1 = comm->iSumDoubles(vals, sum);
+	auto r2 = comm->iAllGatherv(vals, gathered, counts);
+	EXPECT_TRUE(r1->test());
+	EXPECT_TRUE(r2->test());
+	r1->wait();
+	r2->wait();
+	EXPECT_EQ(vals, sum);
+	EXPECT_EQ(vals, gathered);
+	EXPECT_EQ(std::vector<int>{2}, counts);
+}
+
+int main(int argc, char** argv) {
+   ::testing::InitGoogleTest(&argc, argv);
+   return RUN_ALL_TESTS();
+}
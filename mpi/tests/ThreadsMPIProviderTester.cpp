@@ -0,0 +1,175 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <gtest/gtest.h>
+#include "ThreadsMPIProvider.hpp"
+#include <atomic>
+
+using namespace xacc::vqe;
+
+void runOnRanks(const int n,
+		std::function<void(std::shared_ptr<Communicator>)> f) {
+	xacc::setOption("mpi-threads", std::to_string(n));
+	ThreadsMPIProvider provider;
+	provider.initialize();
+	provider.run(f);
+}
+
+TEST(ThreadsMPIProviderTester,checkRankAndSize) {
+
+	for (int n = 2; n <= 4; n++) {
+		std::vector<int> seen(n, 0);
+		runOnRanks(n, [&](std::shared_ptr<Communicator> comm) {
+			EXPECT_EQ(n, comm->size());
+			seen[comm->rank()]++;
+		});
+		EXPECT_EQ(std::vector<int>(n, 1), seen);
+	}
+
+	// Outside of run() there is a single rank
+	ThreadsMPIProvider provider;
+	EXPECT_EQ(1, provider.getCommunicator()->size());
+}
+
+TEST(ThreadsMPIProviderTester,checkBarrier) {
+
+	for (int n = 2; n <= 4; n++) {
+		std::atomic<int> arrived(0);
+		runOnRanks(n, [&](std::shared_ptr<Communicator> comm) {
+			arrived++;
+			// A collective returns only once every rank entered it
+			int one = 1, total = 0;
+			comm->sumInts(one, total);
+			EXPECT_EQ(n, arrived.load());
+			EXPECT_EQ(n, total);
+		});
+	}
+}
+
+TEST(ThreadsMPIProviderTester,checkReductions) {
+
+	for (int n = 2; n <= 4; n++) {
+		runOnRanks(n, [&](std::shared_ptr<Communicator> comm) {
+			auto r = comm->rank();
+
+			double d = r + 0.5, sum = 0.0, max = 0.0;
+			comm->sumDoubles(d, sum);
+			comm->maxDouble(d, max);
+			EXPECT_DOUBLE_EQ(n * (n - 1) / 2.0 + 0.5 * n, sum);
+			EXPECT_DOUBLE_EQ(n - 0.5, max);
+
+			std::vector<double> vals {1.0, (double) r}, sums;
+			comm->sumDoubles(vals, sums);
+			EXPECT_EQ(std::vector<double>({(double) n, n * (n - 1) / 2.0}), sums);
+
+			std::vector<double> b {(double) r};
+			comm->broadcast(b, n - 1);
+			EXPECT_EQ(std::vector<double>{n - 1.0}, b);
+		});
+	}
+}
+
+TEST(ThreadsMPIProviderTester,checkAllGather) {
+
+	for (int n = 2; n <= 4; n++) {
+		runOnRanks(n, [&](std::shared_ptr<Communicator> comm) {
+			auto r = comm->rank();
+
+			std::string s = "rank" + std::to_string(r);
+			std::vector<std::string> all;
+			comm->allGather(s, all);
+			ASSERT_EQ(n, all.size());
+			for (int i = 0; i < n; i++) {
+				EXPECT_EQ("rank" + std::to_string(i), all[i]);
+			}
+
+			// Rank r contributes r + 1 values, concatenated in rank order
+			std::vector<double> mine(r + 1, (double) r), result;
+			std::vector<int> counts;
+			comm->allGatherv(mine, result, counts);
+			std::vector<double> expected;
+			std::vector<int> expectedCounts;
+			for (int i = 0; i < n; i++) {
+				expected.insert(expected.end(), i + 1, (double) i);
+				expectedCounts.push_back(i + 1);
+			}
+			EXPECT_EQ(expected, result);
+			EXPECT_EQ(expectedCounts, counts);
+
+			std::vector<char> bytes(r, 'a' + r), byteResult;
+			comm->gatherv(bytes, byteResult, counts, 0);
+			EXPECT_EQ(n * (n - 1) / 2, byteResult.size());
+			EXPECT_EQ(n, counts.size());
+		});
+	}
+}
+
+TEST(ThreadsMPIProviderTester,checkNonBlocking) {
+
+	for (int n = 2; n <= 4; n++) {
+		runOnRanks(n, [&](std::shared_ptr<Communicator> comm) {
+			auto r = comm->rank();
+			std::vector<double> vals {(double) r}, sum, gathered;
+			std::vector<int> counts;
+			auto r1 = comm->iSumDoubles(vals, sum);
+			auto r2 = comm->iAllGatherv(vals, gathered, counts);
+			r1->wait();
+			EXPECT_TRUE(r2->test());
+			EXPECT_EQ(std::vector<double>{n * (n - 1) / 2.0}, sum);
+			EXPECT_EQ(n, gathered.size());
+			EXPECT_EQ(std::vector<int>(n, 1), counts);
+		});
+	}
+}
+
+TEST(ThreadsMPIProviderTester,checkFailingRank) {
+
+	// The other ranks wait in a collective, they must be
+	// released and the failing rank's exception rethrown
+	for (int n = 2; n <= 4; n++) {
+		try {
+			runOnRanks(n, [&](std::shared_ptr<Communicator> comm) {
+				if (comm->rank() == n - 1) {
+					throw std::runtime_error("rank failed");
+				}
+				int one = 1, total = 0;
+				comm->sumInts(one, total);
+			});
+			FAIL() << "Expected the rank's exception";
+		} catch (std::runtime_error& e) {
+			EXPECT_EQ(std::string("rank failed"), e.what());
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+   ::testing::InitGoogleTest(&argc, argv);
+   return RUN_ALL_TESTS();
+}
@@ -0,0 +1,357 @@
+#ifndef MPI_THREADS_THREADSMPIPROVIDER_HPP_
+#define MPI_THREADS_THREADSMPIPROVIDER_HPP_
+
+#include "MPIProvider.hpp"
+#include "XACC.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * Thrown in the ranks of an aborted ThreadGroup.
+ */
+class ThreadGroupAborted : public std::runtime_error {
+public:
+	ThreadGroupAborted() :
+			std::runtime_error("Another rank of the thread group failed.") {
+	}
+};
+
+/**
+ * A ThreadGroup provides the shared memory for the collectives of a
+ * fixed number of threads. Every collective deposits each rank's data
+ * (as bytes) into its slot, waits for all ranks, copies all slots and
+ * waits again so the slots can be reused by the next collective.
+ *
+ * If a rank fails, abort() releases all ranks waiting in (and all
+ * ranks later entering) a collective with a ThreadGroupAborted
+ * exception, so the group never deadlocks on a missing rank.
+ */
+class ThreadGroup {
+
+protected:
+	int nThreads;
+	std::vector<std::vector<char>> slots;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	int waiting = 0;
+	std::size_t generation = 0;
+	bool aborted = false;
+
+public:
+
+	ThreadGroup(const int n) : nThreads(n), slots(n) {}
+
+	const int size() const {
+		return nThreads;
+	}
+
+	void barrier() {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (aborted) {
+			throw ThreadGroupAborted();
+		}
+		auto gen = generation;
+		if (++waiting == nThreads) {
+			waiting = 0;
+			generation++;
+			cv.notify_all();
+		} else {
+			cv.wait(lock, [&]() { return gen != generation || aborted; });
+			if (gen == generation) {
+				throw ThreadGroupAborted();
+			}
+		}
+	}
+
+	void abort() {
+		std::lock_guard<std::mutex> lock(mutex);
+		aborted = true;
+		cv.notify_all();
+	}
+
+	/**
+	 * Exchange every rank's bytes, returned in rank order.
+	 */
+	std::vector<std::vector<char>> allGather(const int rank,
+			std::vector<char> mine) {
+		slots[rank] = std::move(mine);
+		barrier();
+		auto all = slots;
+		barrier();
+		return all;
+	}
+};
+
+/**
+ * The ThreadCommunicator implements the Communicator for one
+ * thread (rank) of a ThreadGroup. Collectives are computed
+ * identically (in rank order) on every rank, so all ranks get
+ * bit-wise identical results. Non-blocking collectives complete
+ * before they return.
+ */
+class ThreadCommunicator : public Communicator {
+
+protected:
+	std::shared_ptr<ThreadGroup> group;
+	int myRank;
+
+	template<typename T>
+	static std::vector<char> toBytes(const T* data, const std::size_t n) {
+		std::vector<char> bytes(n * sizeof(T));
+		if (n > 0) {
+			std::memcpy(bytes.data(), data, bytes.size());
+		}
+		return bytes;
+	}
+
+	template<typename T>
+	static std::vector<T> fromBytes(const std::vector<char>& bytes) {
+		std::vector<T> data(bytes.size() / sizeof(T));
+		if (!data.empty()) {
+			std::memcpy(data.data(), bytes.data(), bytes.size());
+		}
+		return data;
+	}
+
+	template<typename T>
+	std::vector<std::vector<T>> gather(const std::vector<T>& mine) {
+		auto all = group->allGather(myRank, toBytes(mine.data(), mine.size()));
+		std::vector<std::vector<T>> result;
+		for (auto& b : all) {
+			result.push_back(fromBytes<T>(b));
+		}
+		return result;
+	}
+
+	template<typename T>
+	void concatenate(const std::vector<T>& mine, std::vector<T>& result,
+			std::vector<int>& counts) {
+		auto all = gather(mine);
+		result.clear();
+		counts.clear();
+		for (auto& v : all) {
+			result.insert(result.end(), v.begin(), v.end());
+			counts.push_back(v.size());
+		}
+	}
+
+public:
+
+	ThreadCommunicator(std::shared_ptr<ThreadGroup> g, const int r) :
+			group(g), myRank(r) {
+	}
+
+	virtual const int rank() {
+		return myRank;
+	}
+
+	virtual const int size() {
+		return group->size();
+	}
+
+	virtual void broadcast(std::vector<double>& d, const int r) {
+		d = gather(d)[r];
+	}
+
+	virtual void broadcast(std::string& s, const int r) {
+		auto all = gather(std::vector<char>(s.begin(), s.end()));
+		s = std::string(all[r].begin(), all[r].end());
+	}
+
+	virtual void sumDoubles(double& myVal, double& result) {
+		std::vector<double> mine {myVal}, sum;
+		sumDoubles(mine, sum);
+		result = sum[0];
+	}
+
+	virtual void sumInts(int& myVal, int& result) {
+		result = 0;
+		for (auto& v : gather(std::vector<int> {myVal})) {
+			result += v[0];
+		}
+	}
+
+	virtual void maxDouble(double& myVal, double& result) {
+		auto all = gather(std::vector<double> {myVal});
+		result = all[0][0];
+		for (auto& v : all) {
+			result = std::max(result, v[0]);
+		}
+	}
+
+	virtual void allGather(std::string& myVal, std::vector<std::string>& result) {
+		result.clear();
+		for (auto& b : gather(std::vector<char>(myVal.begin(), myVal.end()))) {
+			result.push_back(std::string(b.begin(), b.end()));
+		}
+	}
+
+	virtual void sumDoubles(std::vector<double>& myVals, std::vector<double>& result) {
+		result.assign(myVals.size(), 0.0);
+		for (auto& v : gather(myVals)) {
+			for (int i = 0; i < result.size(); i++) {
+				result[i] += v[i];
+			}
+		}
+	}
+
+	virtual void gatherv(std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts, const int root) {
+		concatenate(myVals, result, counts);
+	}
+
+	virtual void gatherv(std::vector<char>& myVals, std::vector<char>& result,
+			std::vector<int>& counts, const int root) {
+		concatenate(myVals, result, counts);
+	}
+
+	virtual void allGatherv(std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts) {
+		concatenate(myVals, result, counts);
+	}
+
+	virtual void allGatherv(std::vector<char>& myVals, std::vector<char>& result,
+			std::vector<int>& counts) {
+		concatenate(myVals, result, counts);
+	}
+
+	virtual std::shared_ptr<CommunicatorRequest> iSumDoubles(
+			std::vector<double>& myVals, std::vector<double>& result) {
+		sumDoubles(myVals, result);
+		return std::make_shared<CompletedRequest>();
+	}
+
+	virtual std::shared_ptr<CommunicatorRequest> iAllGatherv(
+			std::vector<double>& myVals, std::vector<double>& result,
+			std::vector<int>& counts) {
+		allGatherv(myVals, result, counts);
+		return std::make_shared<CompletedRequest>();
+	}
+
+	virtual ~ThreadCommunicator() {}
+};
+
+/**
+ * The ThreadsMPIProvider runs ranks as threads of one process. The
+ * number of ranks is given by the mpi-threads option (default: the
+ * number of hardware threads).
+ *
+ * Rank code is launched with run(), which calls the given function
+ * on every rank with that rank's Communicator (xacc-vqe wraps the
+ * whole program in run() if mpi-threads is given). Inside run(),
+ * getCommunicator() returns the calling thread's Communicator,
+ * outside of it a single rank Communicator. All ranks share the
+ * Accelerator, so it must support concurrent execution.
+ */
+class ThreadsMPIProvider : public MPIProvider, public OptionsProvider {
+
+protected:
+
+	int nRanks = 0;
+
+	static std::shared_ptr<Communicator>& current() {
+		static thread_local std::shared_ptr<Communicator> comm;
+		return comm;
+	}
+
+public:
+
+	virtual void initialize() {
+		nRanks = std::max(1u, std::thread::hardware_concurrency());
+		if (xacc::optionExists("mpi-threads")) {
+			nRanks = std::stoi(xacc::getOption("mpi-threads"));
+		}
+	}
+
+	virtual void initialize(int argc, char** argv) {
+		initialize();
+	}
+
+	const int nThreadRanks() const {
+		return nRanks;
+	}
+
+	/**
+	 * Run f on every rank of a new ThreadGroup and wait for all ranks
+	 * to return. The calling thread is rank 0. If a rank throws, the
+	 * group is aborted, so ranks waiting in a collective are released,
+	 * and the first exception is rethrown here.
+	 */
+	virtual void run(std::function<void(std::shared_ptr<Communicator>)> f) {
+		if (!nRanks) {
+			initialize();
+		}
+
+		auto group = std::make_shared<ThreadGroup>(nRanks);
+		std::exception_ptr error;
+		std::mutex errorMutex;
+		auto rankMain = [&](const int r) {
+			try {
+				current() = std::make_shared<ThreadCommunicator>(group, r);
+				f(current());
+			} catch (...) {
+				{
+					std::lock_guard<std::mutex> lock(errorMutex);
+					if (!error) {
+						error = std::current_exception();
+					}
+				}
+				group->abort();
+			}
+			current().reset();
+		};
+
+		std::vector<std::thread> threads;
+		for (int r = 1; r < nRanks; r++) {
+			threads.push_back(std::thread(rankMain, r));
+		}
+		rankMain(0);
+		for (auto& t : threads) {
+			t.join();
+		}
+
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	virtual std::shared_ptr<Communicator> getCommunicator() {
+		if (current()) {
+			return current();
+		}
+		return std::make_shared<ThreadCommunicator>(
+				std::make_shared<ThreadGroup>(1), 0);
+	}
+
+	virtual const std::string name() const {
+		return "threads";
+	}
+
+	virtual const std::string description() const {
+		return "Runs ranks as threads with shared memory collectives.";
+	}
+
+	virtual OptionPairs getOptions() {
+		OptionPairs desc {{"mpi-threads",
+				"Number of thread ranks for the threads MPIProvider "
+				"(default: number of hardware threads)."}};
+		return desc;
+	}
+
+	virtual ~ThreadsMPIProvider() {}
+};
+
+}
+}
+#endif
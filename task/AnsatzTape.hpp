@@ -0,0 +1,182 @@
+#ifndef VQETASKS_ANSATZTAPE_HPP_
+#define VQETASKS_ANSATZTAPE_HPP_
+
+#include "IRProvider.hpp"
+#include "InstructionIterator.hpp"
+#include "xacc_service.hpp"
+#include <regex>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * The AnsatzTape is a compile-once, bind-many form of a variational
+ * state preparation circuit. It holds the flattened, enabled gates of
+ * the ansatz in a single Function, and a list of parameter slots: the
+ * gate parameters that depend on the variational parameters, each
+ * stored as constant + sum_k coefficient_k * x_k.
+ *
+ * Binding new variational parameters only writes the new angles into
+ * the slot instructions, so the same Function can be dispatched every
+ * iteration without re-evaluating or copying the ansatz. The depth and
+ * QASM of the ansatz are computed once at construction.
+ *
+ * The slot coefficients are extracted by evaluating the ansatz at zero
+ * and at the unit vectors, and then checked at one more point. If the
+ * gate parameters are not affine in the variational parameters (or the
+ * circuit structure depends on them) isLinear() returns false and the
+ * tape must not be used.
+ */
+class AnsatzTape {
+
+public:
+  struct Slot {
+    // Position of the instruction on the tape
+    int instruction;
+    // Index of the parameter in that instruction
+    int parameter;
+    double constant;
+    // (variational parameter index, coefficient) pairs
+    std::vector<std::pair<int, double>> coefficients;
+  };
+
+  AnsatzTape(std::shared_ptr<Function> statePrep)
+      : nParameters(statePrep->nParameters()) {
+    auto provider = xacc::getService<IRProvider>("gate");
+
+    std::vector<double> x(nParameters, 0.0);
+    auto base = leafInstructions(statePrep->operator()(x));
+
+    function = provider->createFunction(statePrep->name(), {}, {});
+    for (auto &inst : base) {
+      std::vector<InstructionParameter> params;
+      for (int j = 0; j < inst->nParameters(); j++) {
+        params.push_back(inst->getParameter(j));
+      }
+      auto copy = provider->createInstruction(inst->name(), inst->bits(),
+                                              params);
+      instructions.push_back(copy);
+      function->addInstruction(copy);
+    }
+
+    std::vector<std::vector<InstPtr>> unitLeaves;
+    for (int k = 0; k < nParameters; k++) {
+      x[k] = 1.0;
+      unitLeaves.push_back(leafInstructions(statePrep->operator()(x)));
+      x[k] = 0.0;
+      if (unitLeaves.back().size() != base.size()) {
+        linear = false;
+        return;
+      }
+    }
+
+    for (int i = 0; i < base.size(); i++) {
+      for (int j = 0; j < base[i]->nParameters(); j++) {
+        double constant;
+        if (!toDouble(base[i]->getParameter(j), constant)) {
+          continue;
+        }
+
+        Slot slot{i, j, constant, {}};
+        for (int k = 0; k < nParameters; k++) {
+          double val;
+          toDouble(unitLeaves[k][i]->getParameter(j), val);
+          if (std::fabs(val - constant) > 1e-12) {
+            slot.coefficients.push_back({k, val - constant});
+          }
+        }
+
+        if (!slot.coefficients.empty()) {
+          slots.push_back(slot);
+        }
+      }
+    }
+
+    // Check the affine form at a generic point
+    for (int k = 0; k < nParameters; k++) {
+      x[k] = 0.25 + 0.5 * k / std::max(1, nParameters);
+    }
+    auto check = leafInstructions(statePrep->operator()(x));
+    bind(x);
+    if (check.size() != instructions.size()) {
+      linear = false;
+      return;
+    }
+    for (int i = 0; i < check.size(); i++) {
+      for (int j = 0; j < check[i]->nParameters(); j++) {
+        double expected, actual;
+        if (toDouble(check[i]->getParameter(j), expected) &&
+            toDouble(instructions[i]->getParameter(j), actual) &&
+            std::fabs(expected - actual) > 1e-8) {
+          linear = false;
+          return;
+        }
+      }
+    }
+
+    circuitDepth = function->depth();
+    qasmStr = std::regex_replace(statePrep->toString("q"), std::regex("\\n"),
+                                 "\\\\n");
+  }
+
+  /**
+   * Write the gate parameters for the given variational
+   * parameters into the tape, and return the tape Function.
+   */
+  std::shared_ptr<Function> bind(const std::vector<double> &x) {
+    for (auto &slot : slots) {
+      double val = slot.constant;
+      for (auto &c : slot.coefficients) {
+        val += c.second * x[c.first];
+      }
+      instructions[slot.instruction]->setParameter(slot.parameter,
+                                                   InstructionParameter(val));
+    }
+    return function;
+  }
+
+  const bool isLinear() const { return linear; }
+  const int depth() const { return circuitDepth; }
+  const std::string &qasm() const { return qasmStr; }
+  const std::vector<Slot> &getSlots() const { return slots; }
+  const std::vector<InstPtr> &getInstructions() const { return instructions; }
+  std::shared_ptr<Function> getFunction() { return function; }
+
+protected:
+  int nParameters;
+  bool linear = true;
+  int circuitDepth = 0;
+  std::string qasmStr;
+
+  std::shared_ptr<Function> function;
+  std::vector<InstPtr> instructions;
+  std::vector<Slot> slots;
+
+  static std::vector<InstPtr> leafInstructions(std::shared_ptr<Function> f) {
+    std::vector<InstPtr> leaves;
+    InstructionIterator it(f);
+    while (it.hasNext()) {
+      auto inst = it.next();
+      if (!inst->isComposite() && inst->isEnabled()) {
+        leaves.push_back(inst);
+      }
+    }
+    return leaves;
+  }
+
+  static bool toDouble(InstructionParameter p, double &val) {
+    if (p.which() == 0) {
+      val = (double)mpark::get<int>(p);
+      return true;
+    } else if (p.which() == 1) {
+      val = mpark::get<double>(p);
+      return true;
+    }
+    return false;
+  }
+};
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
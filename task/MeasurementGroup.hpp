@@ -0,0 +1,112 @@
+#ifndef VQETASKS_MEASUREMENTGROUP_HPP_
+#define VQETASKS_MEASUREMENTGROUP_HPP_
+
+#include "CommutingSetGenerator.hpp"
+#include "IRProvider.hpp"
+#include "xacc_service.hpp"
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * A MeasurementGroup is a set of qubit-wise commuting Pauli terms
+ * together with the single measurement circuit (basis rotations
+ * followed by Measure instructions) from whose bit string counts
+ * the expectation value of every term in the set is recovered.
+ */
+class MeasurementGroup {
+
+public:
+  MeasurementGroup(const std::string &name, std::vector<Term> &groupTerms)
+      : terms(groupTerms) {
+
+    std::map<int, std::string> basis;
+    for (auto &t : terms) {
+      auto ops = t.ops();
+      basis.insert(ops.begin(), ops.end());
+    }
+
+    auto provider = xacc::getService<IRProvider>("gate");
+    function = provider->createFunction(name, {}, {});
+    for (auto &kv : basis) {
+      if (kv.second == "X") {
+        function->addInstruction(
+            provider->createInstruction("H", {kv.first}));
+      } else if (kv.second == "Y") {
+        function->addInstruction(provider->createInstruction(
+            "Rx", {kv.first}, {InstructionParameter(M_PI / 2.0)}));
+      }
+    }
+
+    int classicalIdx = 0;
+    for (auto &kv : basis) {
+      function->addInstruction(provider->createInstruction(
+          "Measure", {kv.first}, {InstructionParameter(classicalIdx)}));
+      measuredQubits.push_back(kv.first);
+      classicalIdx++;
+    }
+  }
+
+  /**
+   * Recover the expectation value of the given term (which must
+   * belong to this group) from the measured bit string counts.
+   *
+   * Bit strings are expected to index the measured qubits in
+   * ascending order from right to left, i.e. classical bit 0 is the
+   * rightmost one as in IBM's counts. Bit strings of any other length
+   * (spanning the whole register) are indexed by qubit directly.
+   */
+  const double expectationValue(Term &term,
+                                const std::map<std::string, int> &counts) {
+    std::vector<int> termQubits;
+    for (auto &kv : term.ops()) {
+      termQubits.push_back(kv.first);
+    }
+
+    double sum = 0.0;
+    int nShots = 0;
+    for (auto &kv : counts) {
+      auto &bitStr = kv.first;
+      const int length = bitStr.length();
+      int parity = 0;
+      for (auto q : termQubits) {
+        int position;
+        if (length == measuredQubits.size()) {
+          position = std::distance(measuredQubits.begin(),
+                                   std::find(measuredQubits.begin(),
+                                             measuredQubits.end(), q));
+        } else {
+          position = q;
+        }
+        parity ^= bitStr[length - 1 - position] == '1';
+      }
+      sum += (parity ? -1.0 : 1.0) * kv.second;
+      nShots += kv.second;
+    }
+
+    return nShots > 0 ? sum / nShots : 0.0;
+  }
+
+  std::shared_ptr<Function> function;
+  std::vector<Term> terms;
+  std::vector<int> measuredQubits;
+};
+
+/**
+ * Partition the given operator into qubit-wise commuting
+ * MeasurementGroups. Identity terms are not included.
+ */
+inline std::vector<MeasurementGroup> createMeasurementGroups(PauliOperator &op) {
+  CommutingSetGenerator gen;
+  auto sets = gen.getQubitWiseCommutingSet(op);
+  std::vector<MeasurementGroup> groups;
+  for (int i = 0; i < sets.size(); i++) {
+    groups.push_back(MeasurementGroup("group" + std::to_string(i), sets[i]));
+  }
+  return groups;
+}
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
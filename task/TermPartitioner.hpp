@@ -0,0 +1,54 @@
+#ifndef VQETASKS_TERMPARTITIONER_HPP_
+#define VQETASKS_TERMPARTITIONER_HPP_
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * Assign work items with the given costs to nParts workers with the
+ * longest-processing-time-first heuristic: items are visited by
+ * decreasing cost and each goes to the currently least loaded worker.
+ * The makespan is within 4/3 of optimal, unlike a contiguous split
+ * which can put all expensive items on one worker.
+ *
+ * The result only depends on the costs (ties are broken by index),
+ * so all MPI ranks compute the same assignment independently.
+ *
+ * @param costs The cost of each item
+ * @param nParts The number of workers
+ * @return owners The worker of each item
+ */
+inline std::vector<int> partitionByCost(const std::vector<double> &costs,
+                                        const int nParts) {
+  std::vector<int> order(costs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](const int a, const int b) {
+    return costs[a] > costs[b];
+  });
+
+  // Min-heap of (load, worker)
+  using Load = std::pair<double, int>;
+  std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+  for (int p = 0; p < nParts; p++) {
+    loads.push({0.0, p});
+  }
+
+  std::vector<int> owners(costs.size(), 0);
+  for (auto i : order) {
+    auto least = loads.top();
+    loads.pop();
+    owners[i] = least.second;
+    loads.push({least.first + costs[i], least.second});
+  }
+  return owners;
+}
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
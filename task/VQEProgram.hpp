@@ -9,6 +9,9 @@
 #include "FermionToSpinTransformation.hpp"
 
 #include "MPIProvider.hpp"
+#include "MeasurementGroup.hpp"
+#include "AnsatzTape.hpp"
+#include "UCCSD.hpp"
 #include "CountGatesOfTypeVisitor.hpp"
 
 #include "IRProvider.hpp"
@@ -17,6 +20,7 @@
 #include "xacc_service.hpp"
 
 #include <fstream>
+#include <mutex>
 
 namespace xacc {
 namespace vqe {
@@ -105,6 +109,12 @@ public:
 
 	virtual void build() {
 
+		// Building writes the process wide options and compiler, and
+		// reads the shared FermionToSpinTransformation result, so
+		// ranks running as threads of one process build one at a time
+		static std::mutex buildMutex;
+		std::lock_guard<std::mutex> lock(buildMutex);
+
 		if (pauli == PauliOperator()) {
 			bool userProvidedKernels = false;
 
@@ -219,11 +229,14 @@ public:
 			kernels = getRuntimeKernels();
 		}
 
-		// We don't need state prep if we are diagonalizing, profiling,
-		// generating openfermion scripts, or if we've already been given
-		// an ansatz
+		// We don't need state prep if we are diagonalizing, generating
+		// openfermion scripts, or if we've already been given an ansatz.
+		// Profiles build it only to report its gate statistics.
 		auto task = xacc::getOption("vqe-task");
-		if (!statePrep && (task == "vqe" || task == "compute-energy")) {
+		auto profileAnsatz = task == "vqe-profile"
+				&& xacc::optionExists("n-electrons");
+		if (!statePrep && (task == "vqe" || task == "compute-energy"
+				|| profileAnsatz)) {
 			xacc::info("Creating a StatePreparation Circuit");
 			statePrep = createStatePreparationCircuit();
 
@@ -231,6 +244,20 @@ public:
 			nParameters = statePrep->nParameters();
 		}
 
+		// Flatten the ansatz once, iterations only
+		// bind new angles into the tape (profiles never evaluate it)
+		if (statePrep && task != "vqe-profile") {
+			ansatzTape = std::make_shared<AnsatzTape>(statePrep);
+		}
+
+		// Partition the Hamiltonian into qubit-wise commuting
+		// sets that can share a single measurement circuit
+		if (xacc::optionExists("vqe-qwc-grouping")) {
+			measurementGroups = createMeasurementGroups(pauli);
+			xacc::info("Measuring " + std::to_string(pauli.nTerms())
+					+ " terms with " + std::to_string(measurementGroups.size())
+					+ " qubit-wise commuting measurement groups.");
+		}
 	}
 
 	PauliOperator getPauliOperator() {
@@ -245,12 +272,28 @@ public:
 		return kernels;
 	}
 
+	std::vector<MeasurementGroup>& getMeasurementGroups() {
+		return measurementGroups;
+	}
+
 	std::shared_ptr<Function> getStatePreparationCircuit() {
 		return statePrep;
 	}
 
 	void setStatePreparationCircuit(std::shared_ptr<Function> s) {
 		statePrep = s;
+		ansatzTape.reset();
+	}
+
+	/**
+	 * Return the AnsatzTape for the state preparation circuit,
+	 * or nullptr if the circuit is not affine in its parameters.
+	 */
+	std::shared_ptr<AnsatzTape> getAnsatzTape() {
+		if (!ansatzTape && statePrep) {
+			ansatzTape = std::make_shared<AnsatzTape>(statePrep);
+		}
+		return ansatzTape && ansatzTape->isLinear() ? ansatzTape : nullptr;
 	}
 	const int getNParameters() {
 		return nParameters;
@@ -266,6 +309,23 @@ public:
 		return statePrepType;
 	}
 
+	/**
+	 * Return true if the state preparation circuit was generated
+	 * by UCCSD, which records the gate statistics of the circuit
+	 * before and after its gate cancellation pass.
+	 */
+	const bool hasAnsatzStats() {
+		return ansatzStatsRecorded;
+	}
+
+	const PauliExponentialCircuit::Stats& getUnoptimizedAnsatzStats() {
+		return unoptimizedAnsatzStats;
+	}
+
+	const PauliExponentialCircuit::Stats& getOptimizedAnsatzStats() {
+		return optimizedAnsatzStats;
+	}
+
 	std::shared_ptr<Accelerator> getAccelerator() {
 		return accelerator;
 	}
@@ -292,6 +352,17 @@ public:
 				nQubits);
 	}
 
+	/**
+	 * Return the packed one and two body coefficients of the
+	 * compiled fermion Hamiltonian, built once by the FermionKernel.
+	 */
+	std::shared_ptr<const FermionIntegrals> integrals() {
+		if (!fermionKernel) {
+			xacc::error("Cannot get integrals if you did not compile with FermionCompiler");
+		}
+		return fermionKernel->integrals(nQubits);
+	}
+
     void setGlobalBuffer(std::shared_ptr<AcceleratorBuffer> b) {
         globalBuffer = b;
     }
@@ -323,6 +394,15 @@ protected:
 	 */
 	std::shared_ptr<Function> statePrep;
 
+	/**
+	 * Flattened, slot-indexed form of statePrep.
+	 */
+	std::shared_ptr<AnsatzTape> ansatzTape;
+
+	bool ansatzStatsRecorded = false;
+	PauliExponentialCircuit::Stats unoptimizedAnsatzStats;
+	PauliExponentialCircuit::Stats optimizedAnsatzStats;
+
 	/**
 	 * Reference to the compiled XACC
 	 * Kernels. These kernels each represent
@@ -334,6 +414,13 @@ protected:
 	 */
 	KernelList<> kernels;
 
+	/**
+	 * Qubit-wise commuting partitioning of the
+	 * Hamiltonian, only created if vqe-qwc-grouping
+	 * is set.
+	 */
+	std::vector<MeasurementGroup> measurementGroups;
+
 	PauliOperator pauli = PauliOperator();
 
 	/**
@@ -386,8 +473,16 @@ protected:
 
 			auto statePrepGenerator = xacc::getService<
 					IRGenerator>(statePrepType);
-			return statePrepGenerator->generate(
+			auto function = statePrepGenerator->generate(
 					std::make_shared<AcceleratorBuffer>("", nQubits));
+
+			auto uccsd = std::dynamic_pointer_cast<UCCSD>(statePrepGenerator);
+			if (uccsd) {
+				unoptimizedAnsatzStats = uccsd->getUnoptimizedStats();
+				optimizedAnsatzStats = uccsd->getOptimizedStats();
+				ansatzStatsRecorded = true;
+			}
+			return function;
 		}
 	}
 
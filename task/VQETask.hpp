@@ -76,6 +76,12 @@ public:
 
 	virtual VQETaskResult execute(Eigen::VectorXd parameters) = 0;
 
+	/**
+	 * Return a new instance of this task, so that ranks
+	 * running as threads do not share task state.
+	 */
+	virtual std::shared_ptr<VQETask> clone() = 0;
+
 	virtual void setVQEProgram(std::shared_ptr<VQEProgram> p) {
 		program = p;
 	}
@@ -38,6 +38,8 @@
 #include "VQEMinimizeTask.hpp"
 #include "GenerateOpenFermionEigenspectrumScript.hpp"
 #include "DiagonalizeTask.hpp"
+#include "MatrixFreeDiagonalizeBackend.hpp"
+#include "ParameterShiftVQEBackend.hpp"
 #include "ProfileHamiltonianTask.hpp"
 
 using namespace cppmicroservices;
@@ -63,6 +65,8 @@ public:
 		auto c7 = std::make_shared<xacc::vqe::EigenDiagonalizeBackend>();
 		auto c8 = std::make_shared<xacc::vqe::VQEDummyAccelerator>();
 		auto c9 = std::make_shared<xacc::vqe::GenerateOpenFermionEigenspectrumScript>();
+		auto c10 = std::make_shared<xacc::vqe::MatrixFreeDiagonalizeBackend>();
+		auto c11 = std::make_shared<xacc::vqe::ParameterShiftVQEBackend>();
 
 		context.RegisterService<xacc::vqe::VQETask>(c);
 		context.RegisterService<xacc::vqe::VQETask>(c2);
@@ -76,8 +80,12 @@ public:
 		context.RegisterService<xacc::OptionsProvider>(c6);
 		context.RegisterService<xacc::OptionsProvider>(c3);
 		context.RegisterService<xacc::OptionsProvider>(c2);
+		context.RegisterService<xacc::OptionsProvider>(c11);
 
 		context.RegisterService<xacc::vqe::DiagonalizeBackend>(c7);
+		context.RegisterService<xacc::vqe::DiagonalizeBackend>(c10);
+
+		context.RegisterService<xacc::vqe::VQEBackend>(c11);
 	}
 
 	/**
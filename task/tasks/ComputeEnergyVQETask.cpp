@@ -1,9 +1,17 @@
 #include "ComputeEnergyVQETask.hpp"
 #include "IRProvider.hpp"
 #include "VQEProgram.hpp"
+#include "StateVectorSimulator.hpp"
+#include "TermPartitioner.hpp"
 #include "XACC.hpp"
+#include <atomic>
+#include <chrono>
 #include <iomanip>
+#include <mutex>
 #include <regex>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "xacc_service.hpp"
 
 namespace xacc {
@@ -33,23 +41,147 @@ VQETaskResult ComputeEnergyVQETask::execute(Eigen::VectorXd parameters) {
 
   std::vector<double> vparameters(parameters.data(), parameters.data()+parameters.size());
 
-  // Evaluate our variable parameterized State Prep circuite
-  // to produce a state prep circuit with actual rotations
-  auto evaluatedStatePrep = statePrep->operator()(vparameters);
-  auto optPrep = evaluatedStatePrep->enabledView();
+  std::shared_ptr<Function> optPrep;
+  auto tape = program->getAnsatzTape();
+  if (tape) {
+    // Write the new angles into the compiled ansatz,
+    // its depth and qasm were computed at build time
+    optPrep = tape->bind(vparameters);
+    if (!globalBuffer->hasExtraInfoKey("ansatz-qasm")) {
+      globalBuffer->addExtraInfo("circuit-depth", tape->depth());
+      globalBuffer->addExtraInfo("ansatz-qasm", tape->qasm());
+    }
+  } else {
+    // Evaluate our variable parameterized State Prep circuite
+    // to produce a state prep circuit with actual rotations
+    auto evaluatedStatePrep = statePrep->operator()(vparameters);
+    optPrep = evaluatedStatePrep->enabledView();
 
-  globalBuffer->addExtraInfo("circuit-depth", optPrep->depth());
-  auto qasmStr = optPrep->toString("q");
-  qasmStr = std::regex_replace(qasmStr, std::regex("\\n"),"\\\\n");
+    globalBuffer->addExtraInfo("circuit-depth", optPrep->depth());
+    auto qasmStr = optPrep->toString("q");
+    qasmStr = std::regex_replace(qasmStr, std::regex("\\n"),"\\\\n");
 
-  globalBuffer->addExtraInfo("ansatz-qasm", qasmStr);
+    globalBuffer->addExtraInfo("ansatz-qasm", qasmStr);
+  }
 
   auto getCoeff = [](Kernel<> &k) -> double {
     return std::real(
         k.getIRFunction()->getParameter(0).as<std::complex<double>>());
   };
 
-  if (qpu->name() == "tnqvm" && !xacc::optionExists("vqe-use-mpi")) {
+  if (xacc::optionExists("vqe-exact-expectation")) {
+    // Simulate the ansatz once and evaluate every
+    // term directly from the state vector, no
+    // measurement kernels are executed
+    if (pauliMasks.empty()) {
+      auto H = program->getPauliOperator();
+      pauliMasks = toPauliMasks(H);
+    }
+    StateVectorSimulator simulator(nQubits);
+    simulator.apply(optPrep);
+    sum = simulator.energy(pauliMasks, expVals);
+    totalQpuCalls++;
+  } else if (xacc::optionExists("vqe-qwc-grouping") &&
+             !program->getMeasurementGroups().empty()) {
+    // Execute one circuit per qubit-wise commuting group
+    // and recover every term from the shared counts
+    if (xacc::optionExists("converge-ro-error")) {
+      xacc::error("converge-ro-error is not supported with "
+                  "vqe-qwc-grouping.");
+    }
+
+    auto &groups = program->getMeasurementGroups();
+    double identityCoeff = 0.0;
+    bool hasIdentity = false;
+    if (rank == 0) {
+      for (auto &kv : program->getPauliOperator().getTerms()) {
+        if (kv.second.isIdentity()) {
+          identityCoeff += std::real(kv.second.coeff());
+          hasIdentity = true;
+        }
+      }
+      sum += identityCoeff;
+    }
+
+    // Without MPI every term gets a child buffer with
+    // the counts of its group, as the term kernels do
+    auto computeGroupEnergy =
+        [&](MeasurementGroup &group, std::shared_ptr<AcceleratorBuffer> b,
+            const bool appendChildren) -> double {
+      auto counts = b->getMeasurementCounts();
+      if (counts.empty()) {
+        xacc::error("vqe-qwc-grouping requires an Accelerator that "
+                    "produces measurement counts.");
+      }
+      double groupSum = 0.0;
+      for (auto &t : group.terms) {
+        auto exp = group.expectationValue(t, counts);
+        auto coeff = std::real(t.coeff());
+        groupSum += coeff * exp;
+        expVals.insert({t.id(), exp});
+
+        if (appendChildren) {
+          auto tbuff = qpu->createBuffer(t.id(), nQubits);
+          for (auto &kv : counts) {
+            tbuff->appendMeasurement(kv.first, kv.second);
+          }
+          tbuff->addExtraInfo("kernel", ExtraInfo(t.id()));
+          tbuff->addExtraInfo("measurement-group",
+                              ExtraInfo(group.function->name()));
+          tbuff->addExtraInfo("exp-val-z", ExtraInfo(exp));
+          tbuff->addExtraInfo("coefficient", ExtraInfo(coeff));
+          tbuff->addExtraInfo("parameters", paramsInfo);
+          globalBuffer->appendChild(t.id(), tbuff);
+        }
+      }
+      return groupSum;
+    };
+
+    if (xacc::optionExists("vqe-use-mpi")) {
+      auto buf = qpu->createBuffer("tmp", nQubits);
+      int myStart = (rank)*groups.size() / nRanks;
+      int myEnd = (rank + 1) * groups.size() / nRanks;
+      for (int i = myStart; i < myEnd; i++) {
+        groups[i].function->insertInstruction(0, optPrep);
+        qpu->execute(buf, groups[i].function);
+        groups[i].function->removeInstruction(0);
+        totalQpuCalls++;
+        sum += computeGroupEnergy(groups[i], buf, false);
+        buf->resetBuffer();
+      }
+
+      std::vector<double> local{sum, (double)totalQpuCalls}, global;
+      comm->sumDoubles(local, global);
+      sum = global[0];
+      totalQpuCalls = global[1];
+    } else {
+      std::vector<std::shared_ptr<Function>> ks;
+      for (auto &g : groups) {
+        g.function->insertInstruction(0, optPrep);
+        ks.push_back(g.function);
+      }
+
+      auto results = qpu->execute(globalBuffer, ks);
+      totalQpuCalls += qpu->isRemote() ? 1 : ks.size();
+
+      for (int i = 0; i < results.size(); i++) {
+        sum += computeGroupEnergy(groups[i], results[i], true);
+      }
+
+      if (hasIdentity) {
+        auto ibuff = qpu->createBuffer("I", nQubits);
+        ibuff->addExtraInfo("kernel", ExtraInfo("I"));
+        ibuff->addExtraInfo("exp-val-z", ExtraInfo(1.0));
+        ibuff->addExtraInfo("coefficient", ExtraInfo(identityCoeff));
+        ibuff->addExtraInfo("parameters", paramsInfo);
+        globalBuffer->appendChild("I", ibuff);
+      }
+
+      for (auto &g : groups) {
+        g.function->removeInstruction(0);
+      }
+    }
+  } else if (qpu->name() == "tnqvm" && !xacc::optionExists("vqe-use-mpi")) {
     xacc::setOption("run-and-measure", "");
     std::vector<std::shared_ptr<Function>> ks;
     ks.push_back(optPrep);
@@ -84,9 +216,12 @@ VQETaskResult ComputeEnergyVQETask::execute(Eigen::VectorXd parameters) {
     // kernels.setBufferPostprocessors(program->getBufferPostprocessors());
     for (auto &k : program->getVQEKernels()) {
       if (k.getIRFunction()->nInstructions() > 0) { // IF NOT IDENTITY TERM
-        // If not identity, add the state prep to the circuit
-        k.getIRFunction()->insertInstruction(0, optPrep);
-        kernels.push_back(k);
+        // If not identity, add the state prep to the circuit,
+        // the tape kernels already contain the ansatz
+        if (!tape) {
+          k.getIRFunction()->insertInstruction(0, optPrep);
+          kernels.push_back(k);
+        }
       } else { // IF IS IDENTITY TERM
         // if it is identity, add its coeff to the energy sum
         if (rank == 0) {
@@ -107,25 +242,118 @@ VQETaskResult ComputeEnergyVQETask::execute(Eigen::VectorXd parameters) {
       }
     }
 
+    if (tape) {
+      kernels = getTapeKernels(tape);
+    }
+
     // We can do this in parallel or serially
     if (xacc::optionExists("vqe-use-mpi")) {
       // Allocate some qubits
       auto buf = qpu->createBuffer("tmp", nQubits);
-      int myStart = (rank)*kernels.size() / nRanks;
-      int myEnd = (rank + 1) * kernels.size() / nRanks;
-      for (int i = myStart; i < myEnd; i++) {
-        kernels[i](buf);
-        totalQpuCalls++;
-        sum += getCoeff(kernels[i]) * buf->getExpectationValueZ();
-        buf->resetBuffer();
+
+      // Model the cost of each term circuit by its gate count,
+      // the shared ansatz plus basis rotations and measurements
+      if (termCosts.size() != kernels.size()) {
+        double ansatzCost =
+            tape ? tape->getInstructions().size() : optPrep->nInstructions();
+        termCosts.clear();
+        for (auto &k : kernels) {
+          termCosts.push_back(ansatzCost + k.getIRFunction()->nInstructions() -
+                              (tape ? 1 : 0));
+        }
+      }
+      auto owners = partitionByCost(termCosts, nRanks);
+
+      std::vector<int> myKernels;
+      for (int i = 0; i < kernels.size(); i++) {
+        if (owners[i] == rank) {
+          myKernels.push_back(i);
+        }
+      }
+      // Start the most expensive kernels first
+      std::stable_sort(myKernels.begin(), myKernels.end(),
+                       [&](const int a, const int b) {
+                         return termCosts[a] > termCosts[b];
+                       });
+
+      // Fan this rank's kernels out over vqe-threads threads,
+      // each with its own buffer, and reduce their sums locally
+      int nThreads = xacc::optionExists("vqe-threads")
+                         ? std::stoi(xacc::getOption("vqe-threads"))
+                         : 1;
+      nThreads = std::max(1, std::min(nThreads, (int)myKernels.size()));
+
+      std::vector<double> threadSums(nThreads, 0.0);
+      std::vector<double> termTimes(kernels.size(), 0.0);
+      std::atomic<int> next(0);
+      std::mutex bufferMutex;
+      auto worker = [&](const int t) {
+        std::shared_ptr<AcceleratorBuffer> tbuf = buf;
+        if (t > 0) {
+          std::lock_guard<std::mutex> lock(bufferMutex);
+          tbuf = qpu->createBuffer("tmp" + std::to_string(t), nQubits);
+        }
+        int j;
+        while ((j = next++) < myKernels.size()) {
+          auto i = myKernels[j];
+          auto start = std::chrono::steady_clock::now();
+          kernels[i](tbuf);
+          std::chrono::duration<double> elapsed =
+              std::chrono::steady_clock::now() - start;
+          threadSums[t] += getCoeff(kernels[i]) * tbuf->getExpectationValueZ();
+          tbuf->resetBuffer();
+          termTimes[i] = elapsed.count();
+        }
+      };
+
+      auto start = std::chrono::steady_clock::now();
+      std::vector<std::thread> threads;
+      for (int t = 1; t < nThreads; t++) {
+        threads.push_back(std::thread(worker, t));
+      }
+      worker(0);
+      for (auto &t : threads) {
+        t.join();
+      }
+      std::chrono::duration<double> myTime =
+          std::chrono::steady_clock::now() - start;
+
+      for (auto threadSum : threadSums) {
+        sum += threadSum;
       }
+      totalQpuCalls += myKernels.size();
 
-      double result = 0.0;
-      int ncalls = 0;
-      comm->sumDoubles(sum, result);
-      comm->sumInts(totalQpuCalls, ncalls);
-      totalQpuCalls = ncalls;
-      sum = result;
+      // Share the per rank and per term timings, laid out as
+      // (rank time, term, term time, term, term time, ...),
+      // while the energy and call count are reduced
+      std::vector<double> myTimings{myTime.count()}, allTimings;
+      for (auto i : myKernels) {
+        myTimings.push_back(i);
+        myTimings.push_back(termTimes[i]);
+      }
+      std::vector<int> timingCounts;
+      auto timingRequest =
+          comm->iAllGatherv(myTimings, allTimings, timingCounts);
+
+      std::vector<double> local{sum, (double)totalQpuCalls}, global;
+      comm->sumDoubles(local, global);
+      sum = global[0];
+      totalQpuCalls = global[1];
+
+      // With vqe-mpi-rebalance the measured term times
+      // replace the cost model for the next partitioning
+      timingRequest->wait();
+      std::vector<double> rankTimes;
+      bool rebalance = xacc::optionExists("vqe-mpi-rebalance");
+      int offset = 0;
+      for (auto count : timingCounts) {
+        rankTimes.push_back(allTimings[offset]);
+        for (int j = offset + 1; rebalance && j + 1 < offset + count; j += 2) {
+          termCosts[(int)allTimings[j]] = allTimings[j + 1];
+        }
+        offset += count;
+      }
+      globalBuffer->addExtraInfo("vqe-rank-times", ExtraInfo(rankTimes));
     } else { // THIS IS NOT TNQVM AND NOT MPI
 
       // Execute all nontrivial kernels!
@@ -167,8 +395,10 @@ VQETaskResult ComputeEnergyVQETask::execute(Eigen::VectorXd parameters) {
 
       // Clean up by removing the state prep
       // from the measurement kernels
-      for (auto &k : kernels)
-        k.getIRFunction()->removeInstruction(0);
+      if (!tape) {
+        for (auto &k : kernels)
+          k.getIRFunction()->removeInstruction(0);
+      }
     }
   }
 
@@ -190,7 +420,7 @@ VQETaskResult ComputeEnergyVQETask::execute(Eigen::VectorXd parameters) {
     globalBuffer->addExtraInfo("vqe-angles", paramsInfo);
   }
 
-  globalBuffer->addExtraInfo("vqe-nQPU-calls", ExtraInfo(totalQpuCalls));
+  globalBuffer->addExtraInfo("vqe-nQPU-calls", ExtraInfo(totalQpuCalls.load()));
 
   // See if the user requested data persisitence
   if (persist) {
@@ -213,5 +443,232 @@ VQETaskResult ComputeEnergyVQETask::execute(Eigen::VectorXd parameters) {
   }
 }
 
+KernelList<> &
+ComputeEnergyVQETask::getTapeKernels(std::shared_ptr<AnsatzTape> tape) {
+  if (tapeKernels && tape == kernelsTape) {
+    return *tapeKernels;
+  }
+
+  // Build every measurement circuit once as the tape
+  // function followed by the kernel's measurements
+  auto qpu = program->getAccelerator();
+  auto provider = xacc::getService<IRProvider>("gate");
+  tapeKernels = std::make_shared<KernelList<>>(qpu);
+  for (auto &k : program->getVQEKernels()) {
+    auto f = k.getIRFunction();
+    if (f->nInstructions() == 0) {
+      continue;
+    }
+
+    auto measured = provider->createFunction(f->name(), {}, {});
+    measured->addInstruction(tape->getFunction());
+    for (int i = 0; i < f->nInstructions(); i++) {
+      measured->addInstruction(f->getInstruction(i));
+    }
+    for (int i = 0; i < f->nParameters(); i++) {
+      measured->addParameter(f->getParameter(i));
+    }
+    tapeKernels->push_back(Kernel<>(qpu, measured));
+  }
+
+  kernelsTape = tape;
+  return *tapeKernels;
+}
+
+std::vector<double> ComputeEnergyVQETask::computeEnergies(
+    const std::vector<std::shared_ptr<Function>> &statePreps) {
+
+  auto comm = program->getCommunicator();
+  int rank = comm->rank(), nRanks = comm->size();
+  auto nQubits = program->getNQubits();
+  auto qpu = program->getAccelerator();
+  std::vector<double> energies(statePreps.size(), 0.0);
+
+  if (xacc::optionExists("vqe-exact-expectation")) {
+    if (pauliMasks.empty()) {
+      auto H = program->getPauliOperator();
+      pauliMasks = toPauliMasks(H);
+    }
+    std::map<std::string, double> expVals;
+    for (int i = 0; i < statePreps.size(); i++) {
+      StateVectorSimulator simulator(nQubits);
+      simulator.apply(statePreps[i]);
+      energies[i] = simulator.energy(pauliMasks, expVals);
+      totalQpuCalls++;
+    }
+    return energies;
+  }
+
+  double identityCoeff = 0.0;
+  std::vector<std::shared_ptr<Function>> measurements;
+  std::vector<double> coeffs;
+  for (auto &k : program->getVQEKernels()) {
+    auto f = k.getIRFunction();
+    auto coeff = std::real(f->getParameter(0).as<std::complex<double>>());
+    if (f->nInstructions() > 0) {
+      measurements.push_back(f);
+      coeffs.push_back(coeff);
+    } else {
+      identityCoeff += coeff;
+    }
+  }
+
+  // Pair every state preparation with every measurement kernel,
+  // circuit i measures term i % nTerms of state i / nTerms
+  const int nTerms = measurements.size();
+  const int nCircuits = statePreps.size() * nTerms;
+  int myStart = 0, myEnd = nCircuits;
+  if (xacc::optionExists("vqe-use-mpi")) {
+    myStart = rank * nCircuits / nRanks;
+    myEnd = (rank + 1) * nCircuits / nRanks;
+  }
+
+  auto provider = xacc::getService<IRProvider>("gate");
+  std::vector<std::shared_ptr<Function>> circuits;
+  for (int i = myStart; i < myEnd; i++) {
+    auto &m = measurements[i % nTerms];
+    auto f = provider->createFunction(
+        m->name() + "_" + std::to_string(i / nTerms), {}, {});
+    f->addInstruction(statePreps[i / nTerms]);
+    for (int j = 0; j < m->nInstructions(); j++) {
+      f->addInstruction(m->getInstruction(j));
+    }
+    circuits.push_back(f);
+  }
+
+  if (!circuits.empty()) {
+    auto buffer = qpu->createBuffer("q", nQubits);
+    auto results = qpu->execute(buffer, circuits);
+    if (results.size() != circuits.size()) {
+      xacc::error("Batched energy evaluation expected " +
+                  std::to_string(circuits.size()) + " buffers, but the "
+                  "Accelerator returned " + std::to_string(results.size()));
+    }
+    totalQpuCalls += qpu->isRemote() ? 1 : circuits.size();
+
+    for (int i = 0; i < results.size(); i++) {
+      double exp = 0.0;
+      if (xacc::optionExists("converge-ro-error") &&
+          results[i]->hasExtraInfoKey("ro-fixed-exp-val-z")) {
+        exp = mpark::get<double>(
+            results[i]->getInformation("ro-fixed-exp-val-z"));
+      } else {
+        exp = results[i]->getExpectationValueZ();
+      }
+      auto idx = myStart + i;
+      energies[idx / nTerms] += coeffs[idx % nTerms] * exp;
+    }
+  }
+
+  if (xacc::optionExists("vqe-use-mpi")) {
+    // Reduce all energies and the call count at once
+    auto local = energies;
+    local.push_back(totalQpuCalls);
+    std::vector<double> global;
+    comm->sumDoubles(local, global);
+    totalQpuCalls = global.back();
+    global.pop_back();
+    energies = global;
+  }
+
+  for (auto &e : energies) {
+    e += identityCoeff;
+  }
+
+  return energies;
+}
+
+std::vector<std::future<double>> ComputeEnergyVQETask::executeAsync(
+    const std::vector<Eigen::VectorXd> &parameters) {
+  waitAsync();
+
+  auto promises =
+      std::make_shared<std::vector<std::promise<double>>>(parameters.size());
+  std::vector<std::future<double>> futures;
+  for (auto &p : *promises) {
+    futures.push_back(p.get_future());
+  }
+
+  // Evaluate every candidate into its own circuit, the
+  // AnsatzTape can only be bound to one at a time
+  auto statePrep = program->getStatePreparationCircuit();
+  std::vector<std::shared_ptr<Function>> preps;
+  for (auto &x : parameters) {
+    std::vector<double> vx(x.data(), x.data() + x.size());
+    preps.push_back(statePrep->operator()(vx)->enabledView());
+  }
+  vqeIteration += parameters.size();
+
+  if (!xacc::optionExists("vqe-exact-expectation")) {
+    auto batch = [this, preps, promises]() {
+      std::vector<double> energies;
+      try {
+        energies = computeEnergies(preps);
+      } catch (...) {
+        for (auto &p : *promises) {
+          p.set_exception(std::current_exception());
+        }
+        return;
+      }
+      for (int i = 0; i < energies.size(); i++) {
+        (*promises)[i].set_value(energies[i]);
+      }
+    };
+
+    // MPI collectives stay on the calling thread
+    if (xacc::optionExists("vqe-use-mpi")) {
+      batch();
+    } else {
+      workers.push_back(std::thread(batch));
+    }
+    return futures;
+  }
+
+  if (pauliMasks.empty()) {
+    auto H = program->getPauliOperator();
+    pauliMasks = toPauliMasks(H);
+  }
+  totalQpuCalls += preps.size();
+
+  int nCores = std::max(1u, std::thread::hardware_concurrency());
+  int nThreads = xacc::optionExists("vqe-async-threads")
+                     ? std::stoi(xacc::getOption("vqe-async-threads"))
+                     : nCores;
+  nThreads = std::max(1, std::min(nThreads, (int)preps.size()));
+
+  auto next = std::make_shared<std::atomic<int>>(0);
+  auto nQubits = program->getNQubits();
+  for (int t = 0; t < nThreads; t++) {
+    workers.push_back(std::thread([=]() {
+#ifdef _OPENMP
+      // Share the cores between the workers
+      omp_set_num_threads(std::max(1, nCores / nThreads));
+#endif
+      std::map<std::string, double> expVals;
+      int i;
+      while ((i = (*next)++) < preps.size()) {
+        try {
+          StateVectorSimulator simulator(nQubits);
+          simulator.apply(preps[i]);
+          (*promises)[i].set_value(simulator.energy(pauliMasks, expVals));
+        } catch (...) {
+          (*promises)[i].set_exception(std::current_exception());
+        }
+      }
+    }));
+  }
+
+  return futures;
+}
+
+void ComputeEnergyVQETask::waitAsync() {
+  for (auto &w : workers) {
+    if (w.joinable()) {
+      w.join();
+    }
+  }
+  workers.clear();
+}
+
 } // namespace vqe
 } // namespace xacc
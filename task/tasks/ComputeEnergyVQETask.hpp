@@ -2,6 +2,10 @@
 #define VQETASKS_COMPUTEENERGYVQETASK_HPP_
 
 #include "VQETask.hpp"
+#include "PauliMask.hpp"
+#include <atomic>
+#include <future>
+#include <thread>
 
 namespace xacc {
 namespace vqe {
@@ -15,6 +19,55 @@ public:
 
   virtual VQETaskResult execute(Eigen::VectorXd parameters);
 
+  virtual std::shared_ptr<VQETask> clone() {
+    return std::make_shared<ComputeEnergyVQETask>();
+  }
+
+  /**
+   * Compute the energy of every given (evaluated) state preparation
+   * circuit. All measurement circuits for all state preparations are
+   * submitted to the Accelerator in a single batched execute call
+   * (one call per rank with vqe-use-mpi).
+   *
+   * @param statePreps The evaluated state preparation circuits
+   * @return energies The energy of each state preparation
+   */
+  virtual std::vector<double>
+  computeEnergies(const std::vector<std::shared_ptr<Function>> &statePreps);
+
+  /**
+   * Start computing the energies of a batch of parameter vectors,
+   * returning one future per vector. With vqe-exact-expectation the
+   * candidates are simulated on a pool of vqe-async-threads threads
+   * and each future is ready as soon as its candidate finishes.
+   * Otherwise all candidates are submitted to the Accelerator as one
+   * batch on a background thread (on the calling thread of every rank
+   * with vqe-use-mpi, where all ranks must call this collectively).
+   *
+   * The task must not be used for other evaluations until all
+   * returned futures are ready.
+   *
+   * @param parameters The parameter vectors to evaluate
+   * @return futures The energy of each parameter vector
+   */
+  virtual std::vector<std::future<double>>
+  executeAsync(const std::vector<Eigen::VectorXd> &parameters);
+
+  /**
+   * Wait for all asynchronous evaluations to finish.
+   */
+  void waitAsync();
+
+  virtual ~ComputeEnergyVQETask() { waitAsync(); }
+
+  virtual void setVQEProgram(std::shared_ptr<VQEProgram> p) {
+    program = p;
+    pauliMasks.clear();
+    tapeKernels.reset();
+    kernelsTape.reset();
+    termCosts.clear();
+  }
+
   /**
    * Return the name of this instance.
    *
@@ -38,12 +91,47 @@ public:
     OptionPairs desc {{"vqe-use-mpi", "Use MPI distributed execution."},{
         "vqe-persist-data",
         "Base file name for buffer data."},{
-        "converge-ro-error", "Use ro-fixed-exp-val-z to compute energy."}};
+        "converge-ro-error", "Use ro-fixed-exp-val-z to compute energy."},{
+        "vqe-exact-expectation",
+        "Compute the energy from a simulated state vector instead of "
+        "executing the measurement kernels."},{
+        "vqe-qwc-grouping",
+        "Measure qubit-wise commuting terms with a single circuit."},{
+        "vqe-async-threads",
+        "Number of threads for asynchronous batch evaluations."},{
+        "vqe-mpi-rebalance",
+        "Repartition terms over MPI ranks by their measured execution "
+        "times after every evaluation."},{
+        "vqe-threads",
+        "Number of threads each MPI rank uses to execute its terms, "
+        "the Accelerator must support concurrent execution."}};
     return desc;
   }
 
   int vqeIteration = 0;
-  int totalQpuCalls = 0;
+
+  // Atomic, since executeAsync batches count
+  // their calls on a background thread
+  std::atomic<int> totalQpuCalls{0};
+
+protected:
+  // Bit-packed Hamiltonian terms, built on first
+  // use in vqe-exact-expectation mode
+  std::vector<PauliMask> pauliMasks;
+
+  // Measurement circuits with the ansatz tape prepended,
+  // built once for the tape they were created from
+  std::shared_ptr<KernelList<>> tapeKernels;
+  std::shared_ptr<AnsatzTape> kernelsTape;
+
+  KernelList<> &getTapeKernels(std::shared_ptr<AnsatzTape> tape);
+
+  // Estimated (or with vqe-mpi-rebalance, measured) cost
+  // of every term circuit, used to partition them over ranks
+  std::vector<double> termCosts;
+
+  // Threads running executeAsync evaluations
+  std::vector<std::thread> workers;
 };
 } // namespace vqe
 } // namespace xacc
@@ -19,6 +19,10 @@ public:
 
 	virtual VQETaskResult execute(Eigen::VectorXd parameters);
 
+	virtual std::shared_ptr<VQETask> clone() {
+		return std::make_shared<DiagonalizeTask>();
+	}
+
 	/**
 	 * Return the name of this instance.
 	 *
@@ -45,7 +49,9 @@ public:
 		OptionPairs desc{{"diagonalize-backend",
 							"The backend to use to compute the Hamiltonian eigenspectrum"},{
 			"diag-number-symmetry","Reduce the dimensionality of the problem by considering Hamiltonian subspace spanned by NELEC occupations."},{
-            "print-ground-state","Also print the eigenvector corresponding to the min eigenvalue"}};
+            "print-ground-state","Also print the eigenvector corresponding to the min eigenvalue"},{
+            "diag-sparse","Use a sparse Hamiltonian and a Lanczos eigensolver (default for more than 12 qubits)."},{
+            "diag-krylov-dim","Maximum number of Lanczos steps for the diagonalize-matfree backend (default 300)."}};
 		return desc;
 	}
 
@@ -64,6 +70,7 @@ public:
 class EigenDiagonalizeBackend: public DiagonalizeBackend {
 protected:
     Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> es;
+    Eigen::VectorXcd groundState;
 public:
 
 	double diagonalize(PauliOperator& prog) override;
@@ -0,0 +1,223 @@
+#ifndef VQETASKS_LANCZOSSOLVER_HPP_
+#define VQETASKS_LANCZOSSOLVER_HPP_
+
+#include <Eigen/Dense>
+#include <functional>
+#include <random>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * The LanczosSolver computes the lowest eigenpair of a Hermitian
+ * operator that is only accessible through its action on a vector.
+ *
+ * compute() builds a Krylov basis of at most maxKrylov vectors with
+ * full reorthogonalization, and restarts from the current Ritz vector
+ * until the residual norm drops below the given tolerance. Memory use
+ * is maxKrylov + 2 vectors of the full dimension.
+ *
+ * computeTwoPass() runs the plain three term recurrence for up to
+ * maxKrylov steps instead, and assembles the eigenvector in a second
+ * pass, so it needs only four vectors of the full dimension.
+ */
+class LanczosSolver {
+
+public:
+  using MatVec =
+      std::function<void(const Eigen::VectorXcd &, Eigen::VectorXcd &)>;
+
+  LanczosSolver(MatVec op, const std::size_t dimension,
+                const int maxKrylov = 30, const double tolerance = 1e-10,
+                const int maxRestarts = 100)
+      : matvec(op), dim(dimension), tol(tolerance), restarts(maxRestarts) {
+    krylovDim = std::max(1, (int)std::min<std::size_t>(maxKrylov, dim));
+  }
+
+  /**
+   * Compute the lowest eigenpair, starting from the given vector
+   * or from a (seeded) random vector if start is empty.
+   */
+  void compute(const Eigen::VectorXcd &start = Eigen::VectorXcd()) {
+    Eigen::VectorXcd v = startVector(start);
+
+    std::vector<Eigen::VectorXcd> V;
+    Eigen::VectorXcd w(dim);
+    for (int restart = 0; restart <= restarts; restart++) {
+      V.clear();
+      V.push_back(v);
+      std::vector<double> alpha, beta;
+
+      int m = 0;
+      for (int j = 0; j < krylovDim; j++) {
+        matvec(V[j], w);
+        alpha.push_back(std::real(V[j].dot(w)));
+        m = j + 1;
+
+        // Full reorthogonalization against the Krylov basis
+        for (int i = 0; i <= j; i++) {
+          w -= V[i].dot(w) * V[i];
+        }
+
+        auto b = w.norm();
+        beta.push_back(b);
+        if (b < 1e-12 || j == krylovDim - 1) {
+          break;
+        }
+        V.push_back(w / b);
+      }
+
+      // Diagonalize the projected tridiagonal matrix
+      Eigen::MatrixXd T = Eigen::MatrixXd::Zero(m, m);
+      for (int i = 0; i < m; i++) {
+        T(i, i) = alpha[i];
+        if (i + 1 < m) {
+          T(i, i + 1) = beta[i];
+          T(i + 1, i) = beta[i];
+        }
+      }
+      Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(T);
+      eval = es.eigenvalues()(0);
+      Eigen::VectorXd s = es.eigenvectors().col(0);
+
+      evec = Eigen::VectorXcd::Zero(dim);
+      for (int i = 0; i < m; i++) {
+        evec += s(i) * V[i];
+      }
+      evec.normalize();
+
+      residual = std::abs(beta[m - 1] * s(m - 1));
+      restartsUsed = restart;
+      if (residual < tol * std::max(1.0, std::abs(eval)) || m == dim) {
+        return;
+      }
+
+      v = evec;
+    }
+  }
+
+  /**
+   * Compute the lowest eigenpair with the three term recurrence,
+   * keeping only the previous, current and next Lanczos vectors.
+   * The recurrence coefficients are kept, and the Ritz vector is
+   * assembled by repeating the recurrence from the same start
+   * vector. Without reorthogonalization converged eigenvalues can
+   * reappear as spurious copies, which leaves the lowest one intact.
+   * The second pass is skipped if withEigenvector is false.
+   */
+  void computeTwoPass(const Eigen::VectorXcd &start = Eigen::VectorXcd(),
+                      const bool withEigenvector = true) {
+    const int maxSteps = krylovDim;
+    std::vector<double> alpha, beta;
+    Eigen::VectorXd s;
+    int m = 0;
+
+    Eigen::VectorXcd v = startVector(start);
+    Eigen::VectorXcd vPrev = Eigen::VectorXcd::Zero(dim), w(dim);
+    for (int j = 0; j < maxSteps; j++) {
+      matvec(v, w);
+      alpha.push_back(std::real(v.dot(w)));
+      w -= alpha[j] * v;
+      if (j > 0) {
+        w -= beta[j - 1] * vPrev;
+      }
+      auto b = w.norm();
+      beta.push_back(b);
+      m = j + 1;
+
+      // Check convergence every few steps, on
+      // the Ritz pair of the tridiagonal matrix
+      if (b < 1e-12 || m == maxSteps || m % 10 == 0) {
+        s = lowestRitzVector(alpha, beta, m);
+        residual = std::abs(b * s(m - 1));
+        if (b < 1e-12 || m == maxSteps ||
+            residual < tol * std::max(1.0, std::abs(eval))) {
+          break;
+        }
+      }
+
+      vPrev.swap(v);
+      v = w / b;
+    }
+    restartsUsed = 0;
+    if (!withEigenvector) {
+      return;
+    }
+
+    // Second pass, reusing the coefficients of the first
+    v = startVector(start);
+    vPrev.setZero();
+    evec = s(0) * v;
+    for (int j = 0; j + 1 < m; j++) {
+      matvec(v, w);
+      w -= alpha[j] * v;
+      if (j > 0) {
+        w -= beta[j - 1] * vPrev;
+      }
+      vPrev.swap(v);
+      v = w / beta[j];
+      evec += s(j + 1) * v;
+    }
+    evec.normalize();
+  }
+
+  const double eigenvalue() const { return eval; }
+  const Eigen::VectorXcd &eigenvector() const { return evec; }
+  const double residualNorm() const { return residual; }
+  const int nRestarts() const { return restartsUsed; }
+
+protected:
+  /**
+   * Return the normalized start vector, or a (seeded)
+   * random vector if start is empty.
+   */
+  Eigen::VectorXcd startVector(const Eigen::VectorXcd &start) {
+    Eigen::VectorXcd v = start;
+    if (v.size() != dim) {
+      std::mt19937 gen(1234);
+      std::uniform_real_distribution<double> dist(-1.0, 1.0);
+      v.resize(dim);
+      for (std::size_t i = 0; i < dim; i++) {
+        v(i) = std::complex<double>(dist(gen), dist(gen));
+      }
+    }
+    v.normalize();
+    return v;
+  }
+
+  /**
+   * Set eval to the lowest eigenvalue of the leading m x m block of
+   * the tridiagonal matrix (alpha, beta) and return its eigenvector.
+   */
+  Eigen::VectorXd lowestRitzVector(const std::vector<double> &alpha,
+                                   const std::vector<double> &beta,
+                                   const int m) {
+    Eigen::VectorXd diag(m), subDiag(std::max(0, m - 1));
+    for (int i = 0; i < m; i++) {
+      diag(i) = alpha[i];
+      if (i + 1 < m) {
+        subDiag(i) = beta[i];
+      }
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+    es.computeFromTridiagonal(diag, subDiag, Eigen::ComputeEigenvectors);
+    eval = es.eigenvalues()(0);
+    return es.eigenvectors().col(0);
+  }
+
+  MatVec matvec;
+  std::size_t dim;
+  int krylovDim;
+  double tol;
+  int restarts;
+
+  double eval = 0.0;
+  double residual = 0.0;
+  int restartsUsed = 0;
+  Eigen::VectorXcd evec;
+};
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
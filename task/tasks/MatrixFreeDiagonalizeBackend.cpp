@@ -0,0 +1,48 @@
+#include "MatrixFreeDiagonalizeBackend.hpp"
+#include "LanczosSolver.hpp"
+#include "PauliSumMatVec.hpp"
+#include <iomanip>
+
+namespace xacc {
+namespace vqe {
+
+double MatrixFreeDiagonalizeBackend::diagonalize(PauliOperator &hamiltonian) {
+  auto nQubits = hamiltonian.nQubits();
+  const std::size_t dim = std::size_t(1) << nQubits;
+  PauliSumMatVec H(toMsbFirstPauliMasks(hamiltonian, nQubits));
+
+  int maxSteps = xacc::optionExists("diag-krylov-dim")
+                     ? std::stoi(xacc::getOption("diag-krylov-dim"))
+                     : 300;
+
+  xacc::info("Matrix-free Lanczos on " + std::to_string(nQubits) +
+             " qubits (" + std::to_string(H.nGroups()) +
+             " distinct X masks)");
+
+  // Only the three term recurrence vectors and the
+  // eigenvector are kept, four vectors of size 2^n
+  LanczosSolver solver(H, dim, maxSteps);
+  solver.computeTwoPass();
+  groundState = solver.eigenvector();
+
+  std::stringstream ss;
+  ss << std::setprecision(12) << solver.eigenvalue();
+  xacc::info("Ground State Energy of Hamiltonian = " + ss.str());
+  return solver.eigenvalue();
+}
+
+double
+MatrixFreeDiagonalizeBackend::diagonalize(std::shared_ptr<VQEProgram> prog) {
+  auto hamiltonian = prog->getPauliOperator();
+  return diagonalize(hamiltonian);
+}
+
+std::pair<double, Eigen::VectorXcd>
+MatrixFreeDiagonalizeBackend::diagonalizeWithGroundState(
+    std::shared_ptr<VQEProgram> prog) {
+  auto ground = diagonalize(prog);
+  return {ground, groundState};
+}
+
+} // namespace vqe
+} // namespace xacc
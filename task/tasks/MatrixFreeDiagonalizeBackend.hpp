@@ -0,0 +1,42 @@
+#ifndef VQETASKS_MATRIXFREEDIAGONALIZEBACKEND_HPP_
+#define VQETASKS_MATRIXFREEDIAGONALIZEBACKEND_HPP_
+
+#include "DiagonalizeTask.hpp"
+#include "SparseHamiltonian.hpp"
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * The MatrixFreeDiagonalizeBackend computes the ground state of the
+ * Hamiltonian with Lanczos iterations, applying H to a vector on the fly
+ * from the bit-packed Pauli terms (PauliSumMatVec). The Hamiltonian
+ * matrix and the Krylov basis are never stored: the three term
+ * recurrence runs for at most diag-krylov-dim steps and the ground
+ * state is rebuilt in a second pass, so memory use is four state
+ * vectors (1 GB at 24 qubits) independent of diag-krylov-dim.
+ */
+class MatrixFreeDiagonalizeBackend : public DiagonalizeBackend {
+protected:
+  Eigen::VectorXcd groundState;
+
+public:
+  double diagonalize(PauliOperator &prog) override;
+  double diagonalize(std::shared_ptr<VQEProgram> prog) override;
+  std::pair<double, Eigen::VectorXcd>
+  diagonalizeWithGroundState(std::shared_ptr<VQEProgram> prog) override;
+
+  const std::string name() const override { return "diagonalize-matfree"; }
+
+  /**
+   * Return the description of this instance
+   * @return description The description of this object.
+   */
+  const std::string description() const override {
+    return "Matrix-free Lanczos ground state solver.";
+  }
+};
+
+} // namespace vqe
+} // namespace xacc
+#endif
@@ -0,0 +1,189 @@
+#ifndef VQETASKS_NUMBERSECTOR_HPP_
+#define VQETASKS_NUMBERSECTOR_HPP_
+
+#include <cstdint>
+#include <vector>
+#include "XACC.hpp"
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * The NumberSector enumerates the computational basis states of an
+ * n-qubit register with a fixed number of occupied orbitals, using the
+ * combinatorial number system to map between states and sector indices
+ * in O(n) integer operations.
+ *
+ * States are msb-first bit masks (qubit q is bit nQubits - 1 - q, as
+ * in toMsbFirstPauliMasks), ranked in ascending numeric order, which
+ * is the lexicographic order of the corresponding occupation strings.
+ *
+ * If bravyiKitaev is true, the sector states are the images of the
+ * occupation states under the Bravyi-Kitaev basis change, which is
+ * applied (and inverted) with GF(2) bit mask products.
+ */
+class NumberSector {
+
+public:
+  NumberSector(const int n, const int k, const bool bravyiKitaev = false)
+      : nQubits(n), nElectrons(k), bk(bravyiKitaev) {
+    if (nQubits > 63) {
+      xacc::error("NumberSector supports at most 63 qubits.");
+    }
+
+    binomials.assign(nQubits + 1, std::vector<std::uint64_t>(nQubits + 1, 0));
+    for (int i = 0; i <= nQubits; i++) {
+      binomials[i][0] = 1;
+      for (int j = 1; j <= i; j++) {
+        binomials[i][j] = binomials[i - 1][j - 1] +
+                          (j <= i - 1 ? binomials[i - 1][j] : 0);
+      }
+    }
+
+    if (bk) {
+      buildBravyiKitaevMatrix();
+    }
+  }
+
+  const std::uint64_t size() const { return binomial(nQubits, nElectrons); }
+
+  /**
+   * Return the basis state with the given sector index.
+   */
+  const std::uint64_t state(std::uint64_t idx) const {
+    std::uint64_t v = 0;
+    for (int j = nElectrons; j >= 1; j--) {
+      int p = j - 1;
+      while (p + 1 < nQubits && binomial(p + 1, j) <= idx) {
+        p++;
+      }
+      v |= std::uint64_t(1) << p;
+      idx -= binomial(p, j);
+    }
+    return bk ? reverse(multiply(bkRows, reverse(v))) : v;
+  }
+
+  /**
+   * Return the sector index of the given basis
+   * state, or -1 if it is not in this sector.
+   */
+  const std::int64_t index(std::uint64_t v) const {
+    if (bk) {
+      v = reverse(multiply(bkInverseRows, reverse(v)));
+    }
+    if (__builtin_popcountll(v) != nElectrons) {
+      return -1;
+    }
+    std::uint64_t rank = 0;
+    int j = 1;
+    while (v) {
+      int p = __builtin_ctzll(v);
+      rank += binomial(p, j);
+      v &= v - 1;
+      j++;
+    }
+    return rank;
+  }
+
+  /**
+   * Return the Bravyi-Kitaev matrix rows, bit c of row i
+   * is B(i, c), with qubit indexed rows and columns.
+   */
+  const std::vector<std::uint64_t> &bravyiKitaevRows() const { return bkRows; }
+
+protected:
+  int nQubits;
+  int nElectrons;
+  bool bk;
+  std::vector<std::vector<std::uint64_t>> binomials;
+  std::vector<std::uint64_t> bkRows;
+  std::vector<std::uint64_t> bkInverseRows;
+
+  const std::uint64_t binomial(const int n, const int k) const {
+    return (k < 0 || k > n) ? 0 : binomials[n][k];
+  }
+
+  // Convert between msb-first and qubit indexed masks
+  const std::uint64_t reverse(const std::uint64_t bits) const {
+    std::uint64_t r = 0;
+    for (int q = 0; q < nQubits; q++) {
+      if (bits & (std::uint64_t(1) << q)) {
+        r |= std::uint64_t(1) << (nQubits - 1 - q);
+      }
+    }
+    return r;
+  }
+
+  // GF(2) matrix vector product on qubit indexed masks
+  const std::uint64_t multiply(const std::vector<std::uint64_t> &rows,
+                               const std::uint64_t x) const {
+    std::uint64_t y = 0;
+    for (int i = 0; i < nQubits; i++) {
+      y |= std::uint64_t(__builtin_popcountll(rows[i] & x) & 1) << i;
+    }
+    return y;
+  }
+
+  /**
+   * Build the Seeley BK matrix by doubling, take the trailing
+   * nQubits x nQubits block, and reverse rows and columns
+   * to get the Tranter ordering. Then invert it with
+   * Gauss-Jordan elimination over GF(2).
+   */
+  void buildBravyiKitaevMatrix() {
+    std::vector<std::uint64_t> B{1};
+    int m = 1;
+    while (m < nQubits) {
+      std::vector<std::uint64_t> newB(2 * m, 0);
+      for (int r = 0; r < m; r++) {
+        newB[r] = B[r];
+        newB[m + r] = B[r] << m;
+      }
+      newB[0] |= ((std::uint64_t(1) << m) - 1) << m;
+      B = newB;
+      m *= 2;
+    }
+
+    // Trailing block, then reverse rows and columns
+    auto offset = m - nQubits;
+    auto colMask = nQubits == 64 ? ~std::uint64_t(0)
+                                 : (std::uint64_t(1) << nQubits) - 1;
+    bkRows.assign(nQubits, 0);
+    for (int r = 0; r < nQubits; r++) {
+      auto row = (B[offset + r] >> offset) & colMask;
+      bkRows[nQubits - 1 - r] = reverse(row);
+    }
+
+    // Invert over GF(2), the augmented part starts as the identity
+    auto A = bkRows;
+    bkInverseRows.assign(nQubits, 0);
+    for (int i = 0; i < nQubits; i++) {
+      bkInverseRows[i] = std::uint64_t(1) << i;
+    }
+    for (int c = 0; c < nQubits; c++) {
+      int pivot = -1;
+      for (int r = c; r < nQubits; r++) {
+        if (A[r] & (std::uint64_t(1) << c)) {
+          pivot = r;
+          break;
+        }
+      }
+      if (pivot < 0) {
+        xacc::error("Bravyi-Kitaev matrix is singular.");
+      }
+      std::swap(A[c], A[pivot]);
+      std::swap(bkInverseRows[c], bkInverseRows[pivot]);
+      for (int r = 0; r < nQubits; r++) {
+        if (r != c && (A[r] & (std::uint64_t(1) << c))) {
+          A[r] ^= A[c];
+          bkInverseRows[r] ^= bkInverseRows[c];
+        }
+      }
+    }
+  }
+};
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
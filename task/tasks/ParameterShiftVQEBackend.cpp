@@ -0,0 +1,132 @@
+#include "ParameterShiftVQEBackend.hpp"
+#include "IRProvider.hpp"
+#include "VQEProgram.hpp"
+#include "xacc_service.hpp"
+#include <limits>
+
+namespace xacc {
+namespace vqe {
+
+namespace {
+double angle(InstPtr inst) {
+  auto p = inst->getParameter(0);
+  if (p.which() == 0) {
+    return (double)mpark::get<int>(p);
+  }
+  return mpark::get<double>(p);
+}
+} // namespace
+
+void ParameterShiftVQEBackend::computeGateDerivatives(const int nParameters) {
+  tape = program->getAnsatzTape();
+  if (!tape) {
+    xacc::error("Parameter-shift gradients require a state preparation "
+                "whose gate angles are linear in the parameters.");
+  }
+
+  shiftedGates.clear();
+  auto &instructions = tape->getInstructions();
+  for (auto &slot : tape->getSlots()) {
+    auto name = instructions[slot.instruction]->name();
+    if (name != "Rx" && name != "Ry" && name != "Rz") {
+      xacc::error("Parameter-shift gradients are only supported for "
+                  "parameterized Rx, Ry and Rz gates, not " +
+                  name + ".");
+    }
+
+    Eigen::VectorXd derivatives = Eigen::VectorXd::Zero(nParameters);
+    for (auto &c : slot.coefficients) {
+      derivatives(c.first) = c.second;
+    }
+    shiftedGates.push_back({slot.instruction, derivatives});
+  }
+
+  xacc::info("Parameter-shift gradient over " +
+             std::to_string(shiftedGates.size()) + " parameterized gates, " +
+             std::to_string(2 * shiftedGates.size()) +
+             " circuits per gradient.");
+}
+
+const VQETaskResult
+ParameterShiftVQEBackend::minimize(Eigen::VectorXd parameters) {
+  computeTask = std::make_shared<ComputeEnergyVQETask>(program);
+  computeGateDerivatives(parameters.size());
+
+  cppoptlib::Criteria<double> criteria =
+      cppoptlib::Criteria<double>::defaults();
+  if (xacc::optionExists("vqe-iterations")) {
+    criteria.iterations = std::stoi(xacc::getOption("vqe-iterations"));
+  }
+  if (xacc::optionExists("vqe-gradient-norm")) {
+    criteria.gradNorm = std::stod(xacc::getOption("vqe-gradient-norm"));
+  }
+
+  // L-BFGS does not track the change in energy,
+  // so vqe-energy-delta is checked in callback()
+  energyDelta = xacc::optionExists("vqe-energy-delta")
+                    ? std::stod(xacc::getOption("vqe-energy-delta"))
+                    : 0.0;
+  previousEnergy = std::numeric_limits<double>::max();
+
+  cppoptlib::LbfgsSolver<ParameterShiftVQEBackend> solver;
+  solver.setStopCriteria(criteria);
+  solver.minimize(*this, parameters);
+
+  VQETaskResult result;
+  result.angles = parameters;
+  result.energy = value(parameters);
+  result.nQpuCalls = computeTask->totalQpuCalls;
+  result.vqeIterations = computeTask->vqeIteration;
+  return result;
+}
+
+double ParameterShiftVQEBackend::value(const Eigen::VectorXd &x) {
+  currentEnergy = computeTask->execute(x).energy;
+  return currentEnergy;
+}
+
+void ParameterShiftVQEBackend::gradient(const Eigen::VectorXd &x,
+                                        Eigen::VectorXd &grad) {
+  std::vector<double> vx(x.data(), x.data() + x.size());
+  tape->bind(vx);
+  auto &leaves = tape->getInstructions();
+
+  // Build the +pi/2 and -pi/2 shifted circuit for every
+  // parameterized gate, sharing all other instructions
+  auto provider = xacc::getService<IRProvider>("gate");
+  std::vector<std::shared_ptr<Function>> shifted;
+  for (auto &g : shiftedGates) {
+    auto inst = leaves[g.first];
+    for (auto shift : {M_PI / 2.0, -M_PI / 2.0}) {
+      auto f = provider->createFunction("shifted", {}, {});
+      for (int i = 0; i < leaves.size(); i++) {
+        if (i == g.first) {
+          f->addInstruction(provider->createInstruction(
+              inst->name(), inst->bits(),
+              {InstructionParameter(angle(inst) + shift)}));
+        } else {
+          f->addInstruction(leaves[i]);
+        }
+      }
+      shifted.push_back(f);
+    }
+  }
+
+  auto energies = computeTask->computeEnergies(shifted);
+
+  grad = Eigen::VectorXd::Zero(x.size());
+  for (int i = 0; i < shiftedGates.size(); i++) {
+    grad += shiftedGates[i].second * (energies[2 * i] - energies[2 * i + 1]) /
+            2.0;
+  }
+}
+
+bool ParameterShiftVQEBackend::callback(
+    const cppoptlib::Criteria<double> &state, const Eigen::VectorXd &x) {
+  auto delta = std::fabs(previousEnergy - currentEnergy);
+  previousEnergy = currentEnergy;
+  return delta >= energyDelta;
+}
+
+} // namespace vqe
+} // namespace xacc
@@ -0,0 +1,75 @@
+#ifndef VQETASKS_PARAMETERSHIFTVQEBACKEND_HPP_
+#define VQETASKS_PARAMETERSHIFTVQEBACKEND_HPP_
+
+#include "VQEMinimizeTask.hpp"
+#include "solver/lbfgssolver.h"
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * The ParameterShiftVQEBackend minimizes the energy with the L-BFGS
+ * solver, using analytic parameter-shift gradients.
+ *
+ * The dAngle/dParam coefficients of every parameterized Rx, Ry, Rz gate
+ * are read from the slots of the program's AnsatzTape. The gradient is
+ *
+ *   dE/dp_k = sum_g dAngle_g/dp_k (E(angle_g + pi/2) - E(angle_g - pi/2)) / 2
+ *
+ * and the energies of all 2 x nGates shifted circuits are computed
+ * with one batched ComputeEnergyVQETask::computeEnergies call.
+ */
+class ParameterShiftVQEBackend : public VQEBackend,
+                                 public cppoptlib::Problem<double>,
+                                 public OptionsProvider {
+
+protected:
+  double currentEnergy = 0.0;
+  double previousEnergy = 0.0;
+  double energyDelta = 0.0;
+
+  std::shared_ptr<ComputeEnergyVQETask> computeTask;
+
+  std::shared_ptr<AnsatzTape> tape;
+
+  // Index of every parameterized gate on the ansatz tape, together
+  // with the derivative of its angle wrt every parameter
+  std::vector<std::pair<int, Eigen::VectorXd>> shiftedGates;
+
+  void computeGateDerivatives(const int nParameters);
+
+public:
+  virtual const VQETaskResult minimize(Eigen::VectorXd parameters);
+
+  double value(const Eigen::VectorXd &x);
+
+  void gradient(const Eigen::VectorXd &x, Eigen::VectorXd &grad);
+
+  bool callback(const cppoptlib::Criteria<double> &state,
+                const Eigen::VectorXd &x);
+
+  virtual const std::string name() const { return "lbfgs"; }
+
+  virtual std::shared_ptr<VQEBackend> clone() {
+    return std::make_shared<ParameterShiftVQEBackend>();
+  }
+
+  /**
+   * Return the description of this instance
+   * @return description The description of this object.
+   */
+  virtual const std::string description() const {
+    return "L-BFGS VQE minimization with parameter-shift gradients.";
+  }
+
+  virtual OptionPairs getOptions() {
+    OptionPairs desc{{"vqe-gradient-norm",
+                      "Stop the lbfgs backend when the max norm of the "
+                      "energy gradient drops below this value."}};
+    return desc;
+  }
+};
+
+} // namespace vqe
+} // namespace xacc
+#endif
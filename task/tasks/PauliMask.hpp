@@ -0,0 +1,97 @@
+#ifndef VQETASKS_PAULIMASK_HPP_
+#define VQETASKS_PAULIMASK_HPP_
+
+#include "PauliOperator.hpp"
+#include <cstdint>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * PauliMask is a compact, bit-packed representation of a single
+ * Pauli term acting on at most 64 qubits. Bit q of x (z) is set
+ * if the term has an X (Z) component on qubit q, a Y on qubit q
+ * sets both bits. With this representation the term acts on a
+ * computational basis state |b> as
+ *
+ * P|b> = i^nY (-1)^popcount(b & z) |b ^ x>
+ *
+ * so its action and expectation values can be computed with
+ * integer arithmetic instead of string manipulation.
+ */
+struct PauliMask {
+
+  std::uint64_t x = 0;
+  std::uint64_t z = 0;
+  int nY = 0;
+  std::complex<double> coeff = 0.0;
+  std::string name = "";
+
+  PauliMask() {}
+
+  PauliMask(const std::string &termName, Term &term)
+      : coeff(term.coeff()), name(termName) {
+    for (auto &kv : term.ops()) {
+      if (kv.first >= 64) {
+        xacc::error("PauliMask only supports terms on fewer than 64 qubits.");
+      }
+      auto bit = std::uint64_t(1) << kv.first;
+      if (kv.second == "X") {
+        x |= bit;
+      } else if (kv.second == "Z") {
+        z |= bit;
+      } else if (kv.second == "Y") {
+        x |= bit;
+        z |= bit;
+        nY++;
+      }
+    }
+  }
+
+  /**
+   * Return the phase i^nY picked up by every basis state.
+   */
+  const std::complex<double> phase() const {
+    static const std::complex<double> iPowers[4] = {
+        {1.0, 0.0}, {0.0, 1.0}, {-1.0, 0.0}, {0.0, -1.0}};
+    return iPowers[nY & 3];
+  }
+
+  /**
+   * Return the sign (-1)^popcount(b & z) of this term acting
+   * on the basis state b, the phase is not included.
+   */
+  const double sign(const std::uint64_t b) const {
+    return __builtin_popcountll(b & z) & 1 ? -1.0 : 1.0;
+  }
+
+  /**
+   * Compute the action of this term on the basis state b,
+   * the resulting basis state is written to out and the
+   * amplitude (including the term coefficient) is returned.
+   */
+  const std::complex<double> apply(const std::uint64_t b,
+                                   std::uint64_t &out) const {
+    out = b ^ x;
+    return coeff * phase() * sign(b);
+  }
+
+  const bool isIdentity() const { return x == 0 && z == 0; }
+};
+
+/**
+ * Convert every term of the given PauliOperator
+ * to its PauliMask representation.
+ */
+inline std::vector<PauliMask> toPauliMasks(PauliOperator &op) {
+  std::vector<PauliMask> masks;
+  for (auto &kv : op.getTerms()) {
+    masks.push_back(PauliMask(kv.first, kv.second));
+  }
+  return masks;
+}
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef VQETASKS_PAULISUMMATVEC_HPP_
+#define VQETASKS_PAULISUMMATVEC_HPP_
+
+#include "PauliMask.hpp"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <unordered_map>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * PauliSumMatVec applies a sum of PauliMask terms to a state vector
+ * without storing its matrix. The terms are grouped by X mask and
+ * flattened into plain arrays once, with the phase i^nY folded into
+ * the coefficients, so every product only streams over the arrays.
+ *
+ * Row b of y = H x gathers one amplitude per group,
+ *
+ * y(b) = sum_g (sum_t c_t (-1)^popcount((b ^ x_g) & z_t)) x(b ^ x_g)
+ *
+ * and rows are independent, so they are distributed over OpenMP threads.
+ */
+class PauliSumMatVec {
+
+public:
+  PauliSumMatVec(const std::vector<PauliMask> &masks) {
+    std::unordered_map<std::uint64_t, std::vector<const PauliMask *>> groups;
+    for (auto &m : masks) {
+      groups[m.x].push_back(&m);
+    }
+
+    // Sort for a deterministic ordering, independent
+    // of the unordered PauliOperator term storage
+    for (auto &kv : groups) {
+      xs.push_back(kv.first);
+    }
+    std::sort(xs.begin(), xs.end());
+
+    offsets.push_back(0);
+    for (auto x : xs) {
+      for (auto m : groups[x]) {
+        zs.push_back(m->z);
+        cs.push_back(m->coeff * m->phase());
+      }
+      offsets.push_back(zs.size());
+    }
+  }
+
+  void operator()(const Eigen::VectorXcd &x, Eigen::VectorXcd &y) const {
+    const std::int64_t dim = x.size();
+    const int nGroups = xs.size();
+    y.resize(dim);
+
+#pragma omp parallel for schedule(static)
+    for (std::int64_t row = 0; row < dim; row++) {
+      std::complex<double> sum = 0.0;
+      for (int g = 0; g < nGroups; g++) {
+        const std::uint64_t col = row ^ xs[g];
+        double re = 0.0, im = 0.0;
+        for (int t = offsets[g]; t < offsets[g + 1]; t++) {
+          const double s = __builtin_popcountll(col & zs[t]) & 1 ? -1.0 : 1.0;
+          re += s * std::real(cs[t]);
+          im += s * std::imag(cs[t]);
+        }
+        sum += std::complex<double>(re, im) * x(col);
+      }
+      y(row) = sum;
+    }
+  }
+
+  /**
+   * Return the number of distinct X masks.
+   */
+  const int nGroups() const { return xs.size(); }
+
+protected:
+  std::vector<std::uint64_t> xs;
+  std::vector<int> offsets;
+  std::vector<std::uint64_t> zs;
+  std::vector<std::complex<double>> cs;
+};
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
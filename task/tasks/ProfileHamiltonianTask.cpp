@@ -24,18 +24,9 @@ VQETaskResult ProfileHamiltonianTask::execute(
 		}
 		std::ofstream out(defaultFileName);
 
-		std::shared_ptr<IRTransformation> transform;
-		if (xacc::optionExists("fermion-transformation")) {
-			auto transformStr = xacc::getOption("fermion-transformation");
-			transform = xacc::getService<IRTransformation>(
-					transformStr);
-		} else {
-			transform = xacc::getService<IRTransformation>(
-					"jw");
-		}
-
-		auto hamiltonianInstruction = std::dynamic_pointer_cast<
-				FermionToSpinTransformation>(transform)->getResult();
+		// The Hamiltonian captured at build time, the shared
+		// transformation's result is overwritten by UCCSD
+		auto hamiltonianInstruction = program->getPauliOperator();
 
 		std::stringstream s;
 		s << "Number of Qubits = " << xacc::getOption("n-qubits") << "\n";
@@ -90,6 +81,23 @@ VQETaskResult ProfileHamiltonianTask::execute(
 			<< ", " << std::to_string(it.second) << ")" << "\n";
 		}
 
+		// Report the effect of the exponential reordering and gate
+		// cancellation pass on the UCCSD ansatz built by the program
+		if (program->hasAnsatzStats()) {
+			auto before = program->getUnoptimizedAnsatzStats();
+			auto after = program->getOptimizedAnsatzStats();
+
+			auto depths = "UCCSD Ansatz Depth (before, after optimization) = ("
+					+ std::to_string(before.depth) + ", "
+					+ std::to_string(after.depth) + ")";
+			auto cnots = "UCCSD Ansatz CNOTs (before, after optimization) = ("
+					+ std::to_string(before.nCNOTs) + ", "
+					+ std::to_string(after.nCNOTs) + ")";
+			xacc::info(depths);
+			xacc::info(cnots);
+			s << depths << "\n" << cnots << "\n";
+		}
+
 		auto resultsStr = hamiltonianInstruction.toString();
 		// boost::replace_all(resultsStr, "+", "+\n");
         resultsStr = std::regex_replace(resultsStr, std::regex("\\+"), "+\n");
@@ -18,6 +18,10 @@ public:
 
 	virtual VQETaskResult execute(Eigen::VectorXd parameters);
 
+	virtual std::shared_ptr<VQETask> clone() {
+		return std::make_shared<ProfileHamiltonianTask>();
+	}
+
 	/**
 	 * Return the name of this instance.
 	 *
@@ -0,0 +1,142 @@
+#include "SparseHamiltonian.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace xacc {
+namespace vqe {
+
+std::vector<XMaskGroup> groupByXMask(const std::vector<PauliMask> &masks) {
+  std::unordered_map<std::uint64_t, std::size_t> groupIdx;
+  std::vector<XMaskGroup> groups;
+  for (auto &m : masks) {
+    auto it = groupIdx.find(m.x);
+    if (it == groupIdx.end()) {
+      groupIdx.insert({m.x, groups.size()});
+      XMaskGroup g;
+      g.x = m.x;
+      g.terms.push_back(m);
+      groups.push_back(g);
+    } else {
+      groups[it->second].terms.push_back(m);
+    }
+  }
+
+  // Sort for a deterministic ordering, independent
+  // of the unordered PauliOperator term storage
+  std::sort(groups.begin(), groups.end(),
+            [](const XMaskGroup &a, const XMaskGroup &b) { return a.x < b.x; });
+  return groups;
+}
+
+std::vector<PauliMask> toMsbFirstPauliMasks(PauliOperator &H,
+                                            const int nQubits) {
+  auto reverse = [&](std::uint64_t bits) {
+    std::uint64_t r = 0;
+    for (int q = 0; q < nQubits; q++) {
+      if (bits & (std::uint64_t(1) << q)) {
+        r |= std::uint64_t(1) << (nQubits - 1 - q);
+      }
+    }
+    return r;
+  };
+
+  auto masks = toPauliMasks(H);
+  for (auto &m : masks) {
+    m.x = reverse(m.x);
+    m.z = reverse(m.z);
+  }
+  return masks;
+}
+
+namespace {
+
+/**
+ * Assemble the Hamiltonian restricted to a basis of dim states.
+ * state(i) returns the basis state of row i, index(b) the row
+ * of basis state b, or -1 if b is not part of the basis.
+ */
+template <typename StateFunctor, typename IndexFunctor>
+SparseHamiltonian assemble(const std::vector<XMaskGroup> &groups,
+                           const std::int64_t dim, StateFunctor state,
+                           IndexFunctor index) {
+  using Entry = std::pair<std::int64_t, std::complex<double>>;
+  const int nGroups = groups.size();
+
+  auto rowEntries = [&](const std::int64_t row, std::vector<Entry> &entries) {
+    entries.clear();
+    auto b = state(row);
+    for (int g = 0; g < nGroups; g++) {
+      auto colState = b ^ groups[g].x;
+      std::int64_t col = index(colState);
+      if (col < 0) {
+        continue;
+      }
+      auto val = groups[g].amplitude(colState);
+      if (std::abs(val) > 1e-14) {
+        entries.push_back({col, val});
+      }
+    }
+  };
+
+  // First pass, count the nonzeros in every row
+  std::vector<std::int64_t> rowCounts(dim + 1, 0);
+#pragma omp parallel
+  {
+    std::vector<Entry> entries;
+#pragma omp for schedule(static)
+    for (std::int64_t row = 0; row < dim; row++) {
+      rowEntries(row, entries);
+      rowCounts[row + 1] = entries.size();
+    }
+  }
+
+  for (std::int64_t row = 0; row < dim; row++) {
+    rowCounts[row + 1] += rowCounts[row];
+  }
+
+  SparseHamiltonian H(dim, dim);
+  H.resizeNonZeros(rowCounts[dim]);
+  std::copy(rowCounts.begin(), rowCounts.end(), H.outerIndexPtr());
+
+  // Second pass, fill the column indices and values
+  // of every row into its preallocated slot
+#pragma omp parallel
+  {
+    std::vector<Entry> entries;
+#pragma omp for schedule(static)
+    for (std::int64_t row = 0; row < dim; row++) {
+      rowEntries(row, entries);
+      std::sort(entries.begin(), entries.end(),
+                [](const Entry &a, const Entry &b) { return a.first < b.first; });
+      auto pos = rowCounts[row];
+      for (auto &e : entries) {
+        H.innerIndexPtr()[pos] = e.first;
+        H.valuePtr()[pos] = e.second;
+        pos++;
+      }
+    }
+  }
+
+  return H;
+}
+} // namespace
+
+SparseHamiltonian buildSparseHamiltonian(const std::vector<PauliMask> &masks,
+                                         const int nQubits) {
+  const std::int64_t dim = std::int64_t(1) << nQubits;
+  return assemble(
+      groupByXMask(masks), dim,
+      [](const std::int64_t row) { return std::uint64_t(row); },
+      [](const std::uint64_t b) { return std::int64_t(b); });
+}
+
+SparseHamiltonian buildSectorHamiltonian(const std::vector<PauliMask> &masks,
+                                         const NumberSector &sector) {
+  return assemble(
+      groupByXMask(masks), sector.size(),
+      [&](const std::int64_t row) { return sector.state(row); },
+      [&](const std::uint64_t b) { return sector.index(b); });
+}
+
+} // namespace vqe
+} // namespace xacc
@@ -0,0 +1,66 @@
+#ifndef VQETASKS_SPARSEHAMILTONIAN_HPP_
+#define VQETASKS_SPARSEHAMILTONIAN_HPP_
+
+#include "PauliMask.hpp"
+#include "NumberSector.hpp"
+#include <Eigen/Sparse>
+
+namespace xacc {
+namespace vqe {
+
+using SparseHamiltonian =
+    Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor, std::int64_t>;
+
+/**
+ * Pauli terms that share the same X mask. All terms in
+ * a group connect a basis state to the same column.
+ */
+struct XMaskGroup {
+  std::uint64_t x;
+  std::vector<PauliMask> terms;
+
+  /**
+   * Return the matrix element <b ^ x| sum_t P_t |b>,
+   * i.e. the summed amplitude of the group acting on |b>.
+   */
+  const std::complex<double> amplitude(const std::uint64_t b) const {
+    std::complex<double> sum = 0.0;
+    for (auto &t : terms) {
+      sum += t.coeff * t.phase() * t.sign(b);
+    }
+    return sum;
+  }
+};
+
+/**
+ * Group the given terms by their X mask.
+ */
+std::vector<XMaskGroup> groupByXMask(const std::vector<PauliMask> &masks);
+
+/**
+ * Return the PauliMasks of the given operator indexed so that
+ * qubit q maps to bit (nQubits - 1 - q) of the basis state index,
+ * the ordering used by computeActionOnBra bit strings.
+ */
+std::vector<PauliMask> toMsbFirstPauliMasks(PauliOperator &H,
+                                            const int nQubits);
+
+/**
+ * Assemble the 2^n x 2^n Hamiltonian in compressed row storage.
+ * Rows are computed in parallel, each row holding at most one
+ * entry per distinct X mask.
+ */
+SparseHamiltonian buildSparseHamiltonian(const std::vector<PauliMask> &masks,
+                                         const int nQubits);
+
+/**
+ * Assemble the Hamiltonian restricted to the given particle
+ * number sector, rows and columns are sector indices.
+ */
+SparseHamiltonian buildSectorHamiltonian(const std::vector<PauliMask> &masks,
+                                         const NumberSector &sector);
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
@@ -0,0 +1,186 @@
+#include "StateVectorSimulator.hpp"
+#include "InstructionIterator.hpp"
+#include "XACC.hpp"
+
+namespace xacc {
+namespace vqe {
+
+namespace {
+double toDouble(InstructionParameter p) {
+  if (p.which() == 0) {
+    return (double)mpark::get<int>(p);
+  } else if (p.which() == 1) {
+    return mpark::get<double>(p);
+  }
+  xacc::error("StateVectorSimulator can only simulate evaluated circuits, "
+              "invalid gate parameter type.");
+  return 0.0;
+}
+} // namespace
+
+StateVectorSimulator::StateVectorSimulator(const int n) : nQubits(n) {
+  if (nQubits > 30) {
+    xacc::error("StateVectorSimulator cannot allocate a state vector for " +
+                std::to_string(nQubits) + " qubits.");
+  }
+  reset();
+}
+
+void StateVectorSimulator::reset() {
+  psi.assign(std::uint64_t(1) << nQubits, std::complex<double>(0.0, 0.0));
+  psi[0] = 1.0;
+}
+
+void StateVectorSimulator::apply(std::shared_ptr<Function> circuit) {
+  const std::complex<double> i(0.0, 1.0);
+  const double sqrt2 = 1.0 / std::sqrt(2.0);
+
+  InstructionIterator it(circuit);
+  while (it.hasNext()) {
+    auto inst = it.next();
+    if (inst->isComposite() || !inst->isEnabled()) {
+      continue;
+    }
+
+    auto name = inst->name();
+    auto bits = inst->bits();
+    if (name == "Measure" || name == "I" || name == "Identity") {
+      continue;
+    } else if (name == "H") {
+      applyOneQubitGate(bits[0], sqrt2, sqrt2, sqrt2, -sqrt2);
+    } else if (name == "X") {
+      applyOneQubitGate(bits[0], 0.0, 1.0, 1.0, 0.0);
+    } else if (name == "Y") {
+      applyOneQubitGate(bits[0], 0.0, -i, i, 0.0);
+    } else if (name == "Z") {
+      applyOneQubitGate(bits[0], 1.0, 0.0, 0.0, -1.0);
+    } else if (name == "S") {
+      applyOneQubitGate(bits[0], 1.0, 0.0, 0.0, i);
+    } else if (name == "Sdg") {
+      applyOneQubitGate(bits[0], 1.0, 0.0, 0.0, -i);
+    } else if (name == "T") {
+      applyOneQubitGate(bits[0], 1.0, 0.0, 0.0, std::exp(i * M_PI / 4.0));
+    } else if (name == "Tdg") {
+      applyOneQubitGate(bits[0], 1.0, 0.0, 0.0, std::exp(-i * M_PI / 4.0));
+    } else if (name == "Rx") {
+      auto theta = toDouble(inst->getParameter(0));
+      auto c = std::cos(theta / 2.0), s = std::sin(theta / 2.0);
+      applyOneQubitGate(bits[0], c, -i * s, -i * s, c);
+    } else if (name == "Ry") {
+      auto theta = toDouble(inst->getParameter(0));
+      auto c = std::cos(theta / 2.0), s = std::sin(theta / 2.0);
+      applyOneQubitGate(bits[0], c, -s, s, c);
+    } else if (name == "Rz") {
+      auto theta = toDouble(inst->getParameter(0));
+      applyOneQubitGate(bits[0], std::exp(-i * theta / 2.0), 0.0, 0.0,
+                        std::exp(i * theta / 2.0));
+    } else if (name == "U") {
+      auto theta = toDouble(inst->getParameter(0));
+      auto phi = toDouble(inst->getParameter(1));
+      auto lambda = toDouble(inst->getParameter(2));
+      auto c = std::cos(theta / 2.0), s = std::sin(theta / 2.0);
+      applyOneQubitGate(bits[0], c, -std::exp(i * lambda) * s,
+                        std::exp(i * phi) * s,
+                        std::exp(i * (phi + lambda)) * c);
+    } else if (name == "CNOT") {
+      applyCNOT(bits[0], bits[1]);
+    } else if (name == "CZ") {
+      applyCPhase(bits[0], bits[1], -1.0);
+    } else if (name == "CPhase") {
+      applyCPhase(bits[0], bits[1],
+                  std::exp(i * toDouble(inst->getParameter(0))));
+    } else if (name == "Swap") {
+      applySwap(bits[0], bits[1]);
+    } else {
+      xacc::error("StateVectorSimulator does not support the " + name +
+                  " gate.");
+    }
+  }
+}
+
+void StateVectorSimulator::applyOneQubitGate(const int q,
+                                             const std::complex<double> u00,
+                                             const std::complex<double> u01,
+                                             const std::complex<double> u10,
+                                             const std::complex<double> u11) {
+  const std::int64_t dim = psi.size();
+  const std::uint64_t mask = std::uint64_t(1) << q;
+#pragma omp parallel for
+  for (std::int64_t b = 0; b < dim; b++) {
+    if (!(b & mask)) {
+      auto a0 = psi[b], a1 = psi[b | mask];
+      psi[b] = u00 * a0 + u01 * a1;
+      psi[b | mask] = u10 * a0 + u11 * a1;
+    }
+  }
+}
+
+void StateVectorSimulator::applyCNOT(const int control, const int target) {
+  const std::int64_t dim = psi.size();
+  const std::uint64_t cmask = std::uint64_t(1) << control;
+  const std::uint64_t tmask = std::uint64_t(1) << target;
+#pragma omp parallel for
+  for (std::int64_t b = 0; b < dim; b++) {
+    if ((b & cmask) && !(b & tmask)) {
+      std::swap(psi[b], psi[b | tmask]);
+    }
+  }
+}
+
+void StateVectorSimulator::applyCPhase(const int q1, const int q2,
+                                       const std::complex<double> phase) {
+  const std::int64_t dim = psi.size();
+  const std::uint64_t mask = (std::uint64_t(1) << q1) | (std::uint64_t(1) << q2);
+#pragma omp parallel for
+  for (std::int64_t b = 0; b < dim; b++) {
+    if ((b & mask) == mask) {
+      psi[b] *= phase;
+    }
+  }
+}
+
+void StateVectorSimulator::applySwap(const int q1, const int q2) {
+  const std::int64_t dim = psi.size();
+  const std::uint64_t m1 = std::uint64_t(1) << q1;
+  const std::uint64_t m2 = std::uint64_t(1) << q2;
+#pragma omp parallel for
+  for (std::int64_t b = 0; b < dim; b++) {
+    if ((b & m1) && !(b & m2)) {
+      std::swap(psi[b], psi[(b ^ m1) | m2]);
+    }
+  }
+}
+
+const double StateVectorSimulator::expectation(const PauliMask &term) const {
+  if (term.isIdentity()) {
+    return 1.0;
+  }
+
+  const std::int64_t dim = psi.size();
+  double re = 0.0, im = 0.0;
+#pragma omp parallel for reduction(+ : re, im)
+  for (std::int64_t b = 0; b < dim; b++) {
+    auto val = std::conj(psi[b ^ term.x]) * psi[b] * term.sign(b);
+    re += std::real(val);
+    im += std::imag(val);
+  }
+
+  // P is hermitian, so the imaginary part
+  // vanishes up to round off
+  return std::real(term.phase() * std::complex<double>(re, im));
+}
+
+const double
+StateVectorSimulator::energy(const std::vector<PauliMask> &terms,
+                             std::map<std::string, double> &expVals) const {
+  double sum = 0.0;
+  for (auto &term : terms) {
+    auto exp = expectation(term);
+    expVals[term.name] = exp;
+    sum += std::real(term.coeff * exp);
+  }
+  return sum;
+}
+
+} // namespace vqe
+} // namespace xacc
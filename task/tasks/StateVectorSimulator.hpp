@@ -0,0 +1,73 @@
+#ifndef VQETASKS_STATEVECTORSIMULATOR_HPP_
+#define VQETASKS_STATEVECTORSIMULATOR_HPP_
+
+#include "PauliMask.hpp"
+#include "Function.hpp"
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * The StateVectorSimulator applies an evaluated (non-parameterized)
+ * gate model Function to a dense 2^n state vector and computes
+ * Pauli expectation values directly from the resulting amplitudes.
+ *
+ * Qubit q is mapped to bit q of the basis state index, consistent
+ * with PauliMask. Measure instructions are ignored, so the
+ * expectation values are exact (no shot noise).
+ */
+class StateVectorSimulator {
+
+public:
+  StateVectorSimulator(const int n);
+
+  /**
+   * Reset the state to |0...0>.
+   */
+  void reset();
+
+  /**
+   * Apply all enabled gate instructions of the given
+   * Function to the current state.
+   *
+   * @param circuit The evaluated circuit to apply
+   */
+  void apply(std::shared_ptr<Function> circuit);
+
+  /**
+   * Return the exact expectation value <psi|P|psi> of the
+   * given term, not including the term coefficient.
+   */
+  const double expectation(const PauliMask &term) const;
+
+  /**
+   * Return sum_i Re(c_i <psi|P_i|psi>) over all given terms,
+   * storing every individual expectation value in expVals
+   * keyed on the term name.
+   */
+  const double energy(const std::vector<PauliMask> &terms,
+                      std::map<std::string, double> &expVals) const;
+
+  const std::vector<std::complex<double>> &getState() const { return psi; }
+
+protected:
+  void applyOneQubitGate(const int q, const std::complex<double> u00,
+                         const std::complex<double> u01,
+                         const std::complex<double> u10,
+                         const std::complex<double> u11);
+
+  void applyCNOT(const int control, const int target);
+
+  void applyCPhase(const int q1, const int q2, const std::complex<double> phase);
+
+  void applySwap(const int q1, const int q2);
+
+  int nQubits;
+
+  std::vector<std::complex<double>> psi;
+};
+
+} // namespace vqe
+} // namespace xacc
+
+#endif
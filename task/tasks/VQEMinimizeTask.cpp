@@ -10,9 +10,11 @@ namespace vqe {
 VQETaskResult VQEMinimizeTask::execute(
 		Eigen::VectorXd parameters) {
 
+	// Every execution gets its own backend, the registered
+	// service is shared by all ranks running as threads
 	std::shared_ptr<VQEBackend> backend;
 	if (xacc::optionExists("vqe-backend")) {
-		backend = xacc::getService<VQEBackend>(xacc::getOption("vqe-backend"));
+		backend = xacc::getService<VQEBackend>(xacc::getOption("vqe-backend"))->clone();
 	} else {
 		backend = std::make_shared<CppOptVQEBackend>();
 	}
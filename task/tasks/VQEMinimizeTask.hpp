@@ -18,6 +18,12 @@ protected:
 public:
 	virtual const VQETaskResult minimize(Eigen::VectorXd parameters) = 0;
 	virtual void setProgram(std::shared_ptr<VQEProgram> p) { program = p;}
+
+	/**
+	 * Return a new instance of this backend, so that ranks
+	 * running as threads do not share minimizer state.
+	 */
+	virtual std::shared_ptr<VQEBackend> clone() = 0;
 	virtual ~VQEBackend(){}
 };
 
@@ -56,6 +62,10 @@ public:
 		return "cppopt";
 	}
 
+	virtual std::shared_ptr<VQEBackend> clone() {
+		return std::make_shared<CppOptVQEBackend>();
+	}
+
 	/**
 	 * Return the description of this instance
 	 * @return description The description of this object.
@@ -116,6 +126,10 @@ public:
 
 	virtual VQETaskResult execute(Eigen::VectorXd parameters);
 
+	virtual std::shared_ptr<VQETask> clone() {
+		return std::make_shared<VQEMinimizeTask>();
+	}
+
 	/**
 	 * Return an empty options_description, this is for
 	 * subclasses to implement.
@@ -20,6 +20,10 @@ public:
 		return "tao";
 	}
 
+	virtual std::shared_ptr<VQEBackend> clone() {
+		return std::make_shared<TaoVQEBackend>();
+	}
+
 	/**
 	 * Return the description of this instance
 	 * @return description The description of this object.
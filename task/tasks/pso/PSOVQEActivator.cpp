@@ -43,17 +43,17 @@ namespace {
 
 /**
  */
-class US_ABI_LOCAL TaoVQEActivator: public BundleActivator {
+class US_ABI_LOCAL PSOVQEActivator: public BundleActivator {
 
 public:
 
-	TaoVQEActivator() {
+	PSOVQEActivator() {
 	}
 
 	/**
 	 */
 	void Start(BundleContext context) {
-		auto c7 = std::make_shared<xacc::vqe::TaoVQEBackend>();
+		auto c7 = std::make_shared<xacc::vqe::PsoVQEBackend>();
 		context.RegisterService<xacc::vqe::VQEBackend>(c7);
 		context.RegisterService<xacc::OptionsProvider>(c7);
 	}
@@ -67,4 +67,4 @@ public:
 
 }
 
-CPPMICROSERVICES_EXPORT_BUNDLE_ACTIVATOR(TaoVQEActivator)
+CPPMICROSERVICES_EXPORT_BUNDLE_ACTIVATOR(PSOVQEActivator)
@@ -1,19 +1,111 @@
-#include <boost/functional/hash.hpp>
-#include <unordered_map>
-#include <memory>
-#include "MPIProvider.hpp"
+#include <iomanip>
+#include <limits>
+#include <random>
 #include "PsoVQEBackend.hpp"
 
-using IndexPair = std::pair<std::uint64_t, std::uint64_t>;
-
 namespace xacc {
 namespace vqe {
 
-
 const VQETaskResult PsoVQEBackend::minimize(Eigen::VectorXd parameters) {
+	computeTask = createComputeTask();
+
+	const int dim = parameters.size();
+	int nParticles = 10 + (int) (2 * std::sqrt((double) dim));
+	int maxIterations = 100;
+	double range = M_PI, inertia = 0.7298, c = 1.49618;
+	double energyDelta = 1e-6;
+	int seed = 1234, stallGenerations = 30;
+	if (xacc::optionExists("pso-particles")) {
+		nParticles = std::stoi(xacc::getOption("pso-particles"));
+	}
+	if (xacc::optionExists("vqe-iterations")) {
+		maxIterations = std::stoi(xacc::getOption("vqe-iterations"));
+	}
+	if (xacc::optionExists("pso-range")) {
+		range = std::stod(xacc::getOption("pso-range"));
+	}
+	if (xacc::optionExists("pso-inertia")) {
+		inertia = std::stod(xacc::getOption("pso-inertia"));
+	}
+	if (xacc::optionExists("vqe-energy-delta")) {
+		energyDelta = std::stod(xacc::getOption("vqe-energy-delta"));
+	}
+	if (xacc::optionExists("pso-seed")) {
+		seed = std::stoi(xacc::getOption("pso-seed"));
+	}
+	if (xacc::optionExists("pso-stall-generations")) {
+		stallGenerations = std::stoi(xacc::getOption("pso-stall-generations"));
+	}
+
+	// Every MPI rank draws the same swarm from the same seed
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	std::vector<Eigen::VectorXd> positions(nParticles), velocities(nParticles);
+	for (int i = 0; i < nParticles; i++) {
+		positions[i] = parameters;
+		velocities[i] = Eigen::VectorXd::Zero(dim);
+		for (int k = 0; k < dim; k++) {
+			// Keep the initial parameters as the first particle
+			if (i > 0) {
+				positions[i](k) += range * (2.0 * uniform(gen) - 1.0);
+			}
+			velocities[i](k) = range * (uniform(gen) - 0.5);
+		}
+	}
+
+	auto bestPositions = positions;
+	std::vector<double> bestEnergies(nParticles,
+			std::numeric_limits<double>::max());
+	Eigen::VectorXd globalBest = parameters;
+	double globalBestEnergy = std::numeric_limits<double>::max();
+
+	int iteration = 0, stalled = 0;
+	for (; iteration < maxIterations; iteration++) {
+		auto energies = computeTask->executeAsync(positions);
+
+		auto previousBest = globalBestEnergy;
+		for (int i = 0; i < nParticles; i++) {
+			auto e = energies[i].get();
+			if (e < bestEnergies[i]) {
+				bestEnergies[i] = e;
+				bestPositions[i] = positions[i];
+			}
+			if (e < globalBestEnergy) {
+				globalBestEnergy = e;
+				globalBest = positions[i];
+			}
+		}
+
+		std::stringstream ss;
+		ss << std::setprecision(10) << globalBestEnergy << " at ("
+				<< globalBest.transpose() << ")";
+		xacc::info("PSO Iteration " + std::to_string(iteration)
+						+ ", Best VQE Energy = " + ss.str());
 
+		// Stop when the best energy has not moved by more
+		// than energyDelta for stallGenerations generations
+		stalled = previousBest - globalBestEnergy > energyDelta ? 0 : stalled + 1;
+		if (stalled >= stallGenerations) {
+			break;
+		}
 
+		for (int i = 0; i < nParticles; i++) {
+			for (int k = 0; k < dim; k++) {
+				velocities[i](k) = inertia * velocities[i](k)
+						+ c * uniform(gen) * (bestPositions[i](k) - positions[i](k))
+						+ c * uniform(gen) * (globalBest(k) - positions[i](k));
+			}
+			positions[i] += velocities[i];
+		}
+	}
 
+	VQETaskResult result;
+	result.angles = globalBest;
+	result.energy = globalBestEnergy;
+	result.nQpuCalls = computeTask->totalQpuCalls;
+	result.vqeIterations = iteration;
+	return result;
 }
 
 }
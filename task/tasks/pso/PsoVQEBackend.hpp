@@ -6,12 +6,26 @@
 namespace xacc {
 namespace vqe {
 
+/**
+ * The PsoVQEBackend minimizes the energy with particle swarm
+ * optimization. Every generation the positions of the whole swarm
+ * are submitted at once with ComputeEnergyVQETask::executeAsync, so
+ * all particles are evaluated concurrently, and personal / global
+ * bests are updated as their energies become available.
+ */
 class PsoVQEBackend: public VQEBackend, public OptionsProvider {
 
 protected:
 
 	std::shared_ptr<ComputeEnergyVQETask> computeTask;
 
+	/**
+	 * Create the task that evaluates the swarm's energies.
+	 */
+	virtual std::shared_ptr<ComputeEnergyVQETask> createComputeTask() {
+		return std::make_shared<ComputeEnergyVQETask>(program);
+	}
+
 public:
 
 	virtual const VQETaskResult minimize(Eigen::VectorXd parameters);
@@ -20,28 +34,37 @@ public:
 		return "pso";
 	}
 
+	virtual std::shared_ptr<VQEBackend> clone() {
+		return std::make_shared<PsoVQEBackend>();
+	}
+
 	/**
 	 * Return the description of this instance
 	 * @return description The description of this object.
 	 */
 	virtual const std::string description() const {
-		return "";
+		return "Particle swarm VQE minimization with asynchronous "
+				"batched energy evaluations.";
 	}
 
 	/**
 	 * Return an empty options_description, this is for
 	 * subclasses to implement.
 	 */
-	virtual std::shared_ptr<options_description> getOptions() {
-		auto desc = std::make_shared<options_description>(
-				"Pso Options");
+	virtual OptionPairs getOptions() {
+		OptionPairs desc {{"pso-particles",
+				"Number of particles in the swarm."},{
+				"pso-range",
+				"Particles start uniformly within +/- this "
+				"range of the initial parameters (default pi)."},{
+				"pso-inertia", "Particle velocity inertia weight."},{
+				"pso-seed", "Random seed for the swarm."},{
+				"pso-stall-generations",
+				"Stop after this many generations without "
+				"improving by vqe-energy-delta (default 30)."}};
 		return desc;
 	}
 
-	virtual bool handleOptions(variables_map& map) {
-		return false;
-	}
-
 };
 
 }
@@ -0,0 +1,181 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <gtest/gtest.h>
+#include "PsoVQEBackend.hpp"
+#include "MPIProvider.hpp"
+using namespace xacc::vqe;
+
+const std::string h2Src = R"src(__qpu__ kernel() {
+   0.7137758743754461
+   -1.252477303982147 0 1 0 0
+   0.337246551663004 0 1 1 1 1 0 0 0
+   0.0906437679061661 0 1 1 1 3 0 2 0
+   0.0906437679061661 0 1 2 1 0 0 2 0
+   0.3317360224302783 0 1 2 1 2 0 0 0
+   0.0906437679061661 0 1 3 1 1 0 2 0
+   0.3317360224302783 0 1 3 1 3 0 0 0
+   0.337246551663004 1 1 0 1 0 0 1 0
+   0.0906437679061661 1 1 0 1 2 0 3 0
+   -1.252477303982147 1 1 1 0
+   0.0906437679061661 1 1 2 1 0 0 3 0
+   0.3317360224302783 1 1 2 1 2 0 1 0
+   0.0906437679061661 1 1 3 1 1 0 3 0
+   0.3317360224302783 1 1 3 1 3 0 1 0
+   0.3317360224302783 2 1 0 1 0 0 2 0
+   0.0906437679061661 2 1 0 1 2 0 0 0
+   0.3317360224302783 2 1 1 1 1 0 2 0
+   0.0906437679061661 2 1 1 1 3 0 0 0
+   -0.4759344611440753 2 1 2 0
+   0.0906437679061661 2 1 3 1 1 0 0 0
+   0.3486989747346679 2 1 3 1 3 0 2 0
+   0.3317360224302783 3 1 0 1 0 0 3 0
+   0.0906437679061661 3 1 0 1 2 0 1 0
+   0.3317360224302783 3 1 1 1 1 0 3 0
+   0.0906437679061661 3 1 1 1 3 0 1 0
+   0.0906437679061661 3 1 2 1 0 0 1 0
+   0.3486989747346679 3 1 2 1 2 0 3 0
+   -0.4759344611440753 3 1 3 0
+})src";
+
+// Records the size of every executeAsync batch
+// and counts any one-at-a-time execute calls
+class CountingComputeEnergyVQETask : public ComputeEnergyVQETask {
+public:
+	CountingComputeEnergyVQETask(std::shared_ptr<VQEProgram> prog) :
+			ComputeEnergyVQETask(prog) {
+	}
+
+	virtual VQETaskResult execute(Eigen::VectorXd parameters) {
+		nExecuteCalls++;
+		return ComputeEnergyVQETask::execute(parameters);
+	}
+
+	virtual std::vector<std::future<double>> executeAsync(
+			const std::vector<Eigen::VectorXd> &parameters) {
+		batchSizes.push_back(parameters.size());
+		return ComputeEnergyVQETask::executeAsync(parameters);
+	}
+
+	std::vector<int> batchSizes;
+	int nExecuteCalls = 0;
+};
+
+class CountingPsoVQEBackend : public PsoVQEBackend {
+public:
+	std::shared_ptr<CountingComputeEnergyVQETask> counter;
+
+protected:
+	virtual std::shared_ptr<ComputeEnergyVQETask> createComputeTask() {
+		counter = std::make_shared<CountingComputeEnergyVQETask>(program);
+		return counter;
+	}
+};
+
+std::shared_ptr<VQEProgram> buildH2Program() {
+	auto provider = xacc::getService<MPIProvider>("no-mpi");
+	provider->initialize();
+	auto accelerator = xacc::getAccelerator("vqe-dummy");
+	auto program = std::make_shared<VQEProgram>(accelerator, h2Src,
+			provider->getCommunicator());
+	program->setGlobalBuffer(std::make_shared<AcceleratorBuffer>("q", 4));
+	program->build();
+	return program;
+}
+
+TEST(PsoVQEBackendTester,checkH2) {
+
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+	xacc::setOption("vqe-exact-expectation", "");
+	xacc::setOption("vqe-async-threads", "2");
+	xacc::setOption("pso-particles", "6");
+	xacc::setOption("pso-seed", "7");
+	xacc::setOption("vqe-iterations", "200");
+
+	CountingPsoVQEBackend backend;
+	backend.setProgram(buildH2Program());
+
+	auto result = backend.minimize(Eigen::VectorXd::Zero(2));
+	EXPECT_NEAR(result.energy, -1.13727042207, 1e-3);
+
+	// The whole swarm is evaluated as one executeAsync
+	// batch per generation, never one particle at a time
+	auto &batches = backend.counter->batchSizes;
+	EXPECT_EQ(0, backend.counter->nExecuteCalls);
+	EXPECT_GT(batches.size(), 1u);
+	for (auto size : batches) {
+		EXPECT_EQ(6, size);
+	}
+	EXPECT_EQ(6 * (int) batches.size(), result.nQpuCalls);
+
+	xacc::unsetOption("n-qubits");
+	xacc::unsetOption("n-electrons");
+	xacc::unsetOption("vqe-task");
+	xacc::unsetOption("vqe-exact-expectation");
+	xacc::unsetOption("vqe-async-threads");
+	xacc::unsetOption("pso-particles");
+	xacc::unsetOption("pso-seed");
+	xacc::unsetOption("vqe-iterations");
+}
+
+TEST(PsoVQEBackendTester,checkVQEMinimizeTask) {
+
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+	xacc::setOption("vqe-backend", "pso");
+	xacc::setOption("vqe-exact-expectation", "");
+	xacc::setOption("pso-particles", "6");
+	xacc::setOption("pso-seed", "7");
+	xacc::setOption("vqe-iterations", "200");
+
+	VQEMinimizeTask task(buildH2Program());
+	auto result = task.execute(Eigen::VectorXd::Zero(2));
+	EXPECT_NEAR(result.energy, -1.13727042207, 1e-3);
+
+	xacc::unsetOption("n-qubits");
+	xacc::unsetOption("n-electrons");
+	xacc::unsetOption("vqe-task");
+	xacc::unsetOption("vqe-backend");
+	xacc::unsetOption("vqe-exact-expectation");
+	xacc::unsetOption("pso-particles");
+	xacc::unsetOption("pso-seed");
+	xacc::unsetOption("vqe-iterations");
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc,argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -30,16 +30,15 @@
  **********************************************************************************/
 #include <gtest/gtest.h>
 #include "ComputeEnergyVQETask.hpp"
+#include "StateVectorSimulator.hpp"
+#include "TermPartitioner.hpp"
 #include "MPIProvider.hpp"
+#include "ThreadsMPIProvider.hpp"
+#include <cmath>
 #include <iostream>
 using namespace xacc::vqe;
 
-TEST(ComputeEnergyVQETaskTester,checkSimple) {
-
-	auto argc = xacc::getArgc();
-	auto argv = xacc::getArgv();
-
-	const std::string src = R"src(__qpu__ kernel() {
+const std::string h2Src = R"src(__qpu__ kernel() {
    0.7137758743754461
    -1.252477303982147 0 1 0 0
    0.337246551663004 0 1 1 1 1 0 0 0
@@ -71,6 +70,91 @@ TEST(ComputeEnergyVQETaskTester,checkSimple) {
    -0.4759344611440753 3 1 3 0
 })src";
 
+/**
+ * The vqe-dummy Accelerator refuses to execute, so the MPI
+ * branch is exercised with this one. It simulates every kernel
+ * exactly and records the outcome probabilities of the measured
+ * qubits as counts over 2^30 shots. Bit strings follow the IBM
+ * convention: classical bit 0, the first Measure, is rightmost.
+ */
+class SimulatedAccelerator : public xacc::Accelerator {
+public:
+	virtual void initialize() {}
+	virtual AcceleratorType getType() { return AcceleratorType::qpu_gate; }
+	virtual std::vector<std::shared_ptr<IRTransformation>> getIRTransformations() {
+		return std::vector<std::shared_ptr<IRTransformation>> {};
+	}
+	virtual void execute(std::shared_ptr<AcceleratorBuffer> buffer,
+				const std::shared_ptr<Function> function) {
+		StateVectorSimulator sim(buffer->size());
+		sim.apply(function);
+
+		std::vector<int> measured;
+		for (int i = 0; i < function->nInstructions(); i++) {
+			auto inst = function->getInstruction(i);
+			if (inst->name() == "Measure") {
+				measured.push_back(inst->bits()[0]);
+			}
+		}
+
+		std::vector<double> probabilities(1 << measured.size(), 0.0);
+		auto& psi = sim.getState();
+		for (std::uint64_t b = 0; b < psi.size(); b++) {
+			int outcome = 0;
+			for (int c = 0; c < measured.size(); c++) {
+				outcome |= ((b >> measured[c]) & 1) << c;
+			}
+			probabilities[outcome] += std::norm(psi[b]);
+		}
+
+		const int nShots = 1 << 30;
+		for (int outcome = 0; outcome < probabilities.size(); outcome++) {
+			int count = std::round(probabilities[outcome] * nShots);
+			if (count > 0) {
+				std::string bitStr(measured.size(), '0');
+				for (int c = 0; c < measured.size(); c++) {
+					if ((outcome >> c) & 1) {
+						bitStr[measured.size() - 1 - c] = '1';
+					}
+				}
+				buffer->appendMeasurement(bitStr, count);
+			}
+		}
+	}
+	virtual std::vector<std::shared_ptr<AcceleratorBuffer>> execute(
+			std::shared_ptr<AcceleratorBuffer> buffer,
+			const std::vector<std::shared_ptr<Function>> functions) {
+		std::vector<std::shared_ptr<AcceleratorBuffer>> results;
+		for (auto& f : functions) {
+			auto b = std::make_shared<AcceleratorBuffer>(f->name(),
+					buffer->size());
+			execute(b, f);
+			results.push_back(b);
+		}
+		return results;
+	}
+	virtual std::shared_ptr<AcceleratorBuffer> createBuffer(
+				const std::string& varId) {
+		return createBuffer(varId, 1);
+	}
+	virtual std::shared_ptr<AcceleratorBuffer> createBuffer(
+			const std::string& varId, const int size) {
+		return std::make_shared<AcceleratorBuffer>(varId, size);
+	}
+	virtual bool isValidBufferSize(const int NBits) {
+		return true;
+	}
+	virtual const std::string name() const { return "simulated"; }
+	virtual const std::string description() const {return "";}
+};
+
+TEST(ComputeEnergyVQETaskTester,checkSimple) {
+
+	auto argc = xacc::getArgc();
+	auto argv = xacc::getArgv();
+
+	const std::string src = h2Src;
+
 	std::shared_ptr<MPIProvider> provider;
 	if (xacc::hasService<MPIProvider>("boost-mpi")) {
 		provider = xacc::getService<MPIProvider>("boost-mpi");
@@ -108,6 +192,286 @@ TEST(ComputeEnergyVQETaskTester,checkSimple) {
 
 }
 
+TEST(ComputeEnergyVQETaskTester,checkExactExpectation) {
+
+	auto provider = xacc::getService<MPIProvider>("no-mpi");
+	provider->initialize();
+	auto world = provider->getCommunicator();
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+	xacc::setOption("vqe-exact-expectation", "");
+
+	// The state vector is simulated by the task itself,
+	// so no real Accelerator is required
+	auto accelerator = xacc::getAccelerator("vqe-dummy");
+	auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
+	program->setGlobalBuffer(std::make_shared<AcceleratorBuffer>("q", 4));
+	program->build();
+
+	ComputeEnergyVQETask task;
+	task.setVQEProgram(program);
+
+	Eigen::VectorXd parameters(2);
+	parameters << 0, -.0571583356234;
+	VQETaskResult result = task.execute(parameters);
+	EXPECT_NEAR(result.energy, -1.13727042207, 1e-4);
+	EXPECT_EQ(result.expVals.size(), program->getPauliOperator().nTerms());
+
+	xacc::unsetOption("vqe-exact-expectation");
+}
+
+TEST(ComputeEnergyVQETaskTester,checkAnsatzTape) {
+
+	auto provider = xacc::getService<MPIProvider>("no-mpi");
+	provider->initialize();
+	auto world = provider->getCommunicator();
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+
+	auto accelerator = xacc::getAccelerator("vqe-dummy");
+	auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
+	program->setGlobalBuffer(std::make_shared<AcceleratorBuffer>("q", 4));
+	program->build();
+
+	auto tape = program->getAnsatzTape();
+	EXPECT_TRUE(tape != nullptr);
+	EXPECT_FALSE(tape->getSlots().empty());
+
+	// Binding the tape must give the same state
+	// as evaluating the state preparation
+	auto H = program->getPauliOperator();
+	auto masks = toPauliMasks(H);
+	std::map<std::string, double> expVals;
+	for (auto x : std::vector<std::vector<double>>{{0.1, -0.3}, {1.2, 0.7}}) {
+		StateVectorSimulator evaluated(4), bound(4);
+		evaluated.apply(program->getStatePreparationCircuit()->operator()(x));
+		bound.apply(tape->bind(x));
+		EXPECT_NEAR(evaluated.energy(masks, expVals),
+				bound.energy(masks, expVals), 1e-10);
+	}
+}
+
+TEST(ComputeEnergyVQETaskTester,checkExecuteAsync) {
+
+	auto provider = xacc::getService<MPIProvider>("no-mpi");
+	provider->initialize();
+	auto world = provider->getCommunicator();
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+	xacc::setOption("vqe-exact-expectation", "");
+	xacc::setOption("vqe-async-threads", "3");
+
+	auto accelerator = xacc::getAccelerator("vqe-dummy");
+	auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
+	program->setGlobalBuffer(std::make_shared<AcceleratorBuffer>("q", 4));
+	program->build();
+
+	ComputeEnergyVQETask task(program);
+
+	std::vector<Eigen::VectorXd> batch;
+	for (int i = 0; i < 8; i++) {
+		Eigen::VectorXd x(2);
+		x << 0.1 * i, -0.05 * i;
+		batch.push_back(x);
+	}
+
+	auto futures = task.executeAsync(batch);
+	EXPECT_EQ(batch.size(), futures.size());
+	std::vector<double> energies;
+	for (auto& f : futures) {
+		energies.push_back(f.get());
+	}
+
+	// The task must not be reused before all evaluations finished
+	task.waitAsync();
+	for (int i = 0; i < batch.size(); i++) {
+		EXPECT_NEAR(task.execute(batch[i]).energy, energies[i], 1e-10);
+	}
+
+	xacc::unsetOption("vqe-async-threads");
+	xacc::unsetOption("vqe-exact-expectation");
+}
+
+TEST(ComputeEnergyVQETaskTester,checkMPIThreads) {
+
+	auto provider = xacc::getService<MPIProvider>("no-mpi");
+	provider->initialize();
+	auto world = provider->getCommunicator();
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+
+	auto accelerator = std::make_shared<SimulatedAccelerator>();
+	Eigen::VectorXd x(2);
+	x << 0.1, -0.0571583356234;
+
+	// Evaluate the same energy serially, on the MPI branch with
+	// a single thread and fanned out over vqe-threads threads
+	auto run = [&](const bool useMPI, const std::string& nThreads) {
+		if (useMPI) {
+			xacc::setOption("vqe-use-mpi", "");
+		}
+		if (!nThreads.empty()) {
+			xacc::setOption("vqe-threads", nThreads);
+		}
+
+		auto buffer = std::make_shared<AcceleratorBuffer>("q", 4);
+		auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
+		program->setGlobalBuffer(buffer);
+		program->build();
+
+		ComputeEnergyVQETask task(program);
+		auto energy = task.execute(x).energy;
+		auto nCalls = mpark::get<int>(buffer->getInformation("vqe-nQPU-calls"));
+
+		xacc::unsetOption("vqe-threads");
+		xacc::unsetOption("vqe-use-mpi");
+		return std::make_pair(energy, nCalls);
+	};
+
+	auto serial = run(false, "");
+	auto mpi = run(true, "");
+	auto threaded = run(true, "3");
+
+	// Counts are rounded to 2^-30, the exact energy is known
+	// from the state vector
+	auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
+	program->setGlobalBuffer(std::make_shared<AcceleratorBuffer>("q", 4));
+	program->build();
+	auto H = program->getPauliOperator();
+	auto masks = toPauliMasks(H);
+	std::map<std::string, double> expVals;
+	StateVectorSimulator sim(4);
+	sim.apply(program->getStatePreparationCircuit()->operator()(
+			std::vector<double> { x(0), x(1) }));
+	EXPECT_NEAR(sim.energy(masks, expVals), serial.first, 1e-6);
+
+	EXPECT_NEAR(serial.first, mpi.first, 1e-10);
+	EXPECT_NEAR(serial.first, threaded.first, 1e-10);
+	EXPECT_GT(serial.second, 0);
+	EXPECT_EQ(serial.second, mpi.second);
+	EXPECT_EQ(serial.second, threaded.second);
+}
+
+TEST(ComputeEnergyVQETaskTester,checkQubitWiseGrouping) {
+
+	auto provider = xacc::getService<MPIProvider>("no-mpi");
+	provider->initialize();
+	auto world = provider->getCommunicator();
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+
+	auto accelerator = std::make_shared<SimulatedAccelerator>();
+	Eigen::VectorXd x(2);
+	x << 0.1, -0.0571583356234;
+
+	auto run = [&](const std::string& option, const bool useMPI) {
+		if (!option.empty()) {
+			xacc::setOption(option, "");
+		}
+		if (useMPI) {
+			xacc::setOption("vqe-use-mpi", "");
+		}
+		auto buffer = std::make_shared<AcceleratorBuffer>("q", 4);
+		auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
+		program->setGlobalBuffer(buffer);
+		program->build();
+
+		ComputeEnergyVQETask task(program);
+		auto energy = task.execute(x).energy;
+		xacc::unsetOption("vqe-use-mpi");
+		if (!option.empty()) {
+			xacc::unsetOption(option);
+		}
+		return std::make_pair(energy, buffer);
+	};
+
+	auto exact = run("vqe-exact-expectation", false);
+	auto ungrouped = run("", false);
+	auto grouped = run("vqe-qwc-grouping", false);
+	auto groupedMPI = run("vqe-qwc-grouping", true);
+
+	// Counts are rounded to 2^-30 of the shots
+	EXPECT_NEAR(exact.first, ungrouped.first, 1e-6);
+	EXPECT_NEAR(exact.first, grouped.first, 1e-6);
+	EXPECT_NEAR(grouped.first, groupedMPI.first, 1e-10);
+
+	// Every term is reported as a child, as without grouping
+	ExtraInfo params(std::vector<double> { x(0), x(1) });
+	std::map<std::string, double> ungroupedExps;
+	for (auto& c : ungrouped.second->getChildren("parameters", params)) {
+		ungroupedExps[mpark::get<std::string>(c->getInformation("kernel"))] =
+				mpark::get<double>(c->getInformation("exp-val-z"));
+	}
+	auto children = grouped.second->getChildren("parameters", params);
+	EXPECT_EQ(ungroupedExps.size(), children.size());
+	for (auto& c : children) {
+		auto kernel = mpark::get<std::string>(c->getInformation("kernel"));
+		EXPECT_TRUE(c->hasExtraInfoKey("coefficient"));
+		EXPECT_EQ(1, ungroupedExps.count(kernel));
+		EXPECT_NEAR(ungroupedExps[kernel],
+				mpark::get<double>(c->getInformation("exp-val-z")), 1e-6);
+	}
+}
+
+TEST(ComputeEnergyVQETaskTester,checkThreadRanks) {
+
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+	xacc::setOption("vqe-use-mpi", "");
+	xacc::setOption("mpi-threads", "2");
+
+	auto accelerator = std::make_shared<SimulatedAccelerator>();
+	Eigen::VectorXd x(2);
+	x << 0, -0.0571583356234;
+
+	// Every rank builds its own program and splits the
+	// terms with the other rank, as xacc-vqe does
+	ThreadsMPIProvider provider;
+	provider.initialize();
+	std::vector<double> energies(2, 0.0);
+	provider.run([&](std::shared_ptr<Communicator> world) {
+		auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
+		program->setGlobalBuffer(std::make_shared<AcceleratorBuffer>("q", 4));
+		program->build();
+
+		int built = 1, nBuilt = 0;
+		world->sumInts(built, nBuilt);
+		EXPECT_EQ(2, nBuilt);
+
+		ComputeEnergyVQETask task(program);
+		energies[world->rank()] = task.execute(x).energy;
+	});
+
+	EXPECT_NEAR(-1.13727042207, energies[0], 1e-4);
+	EXPECT_NEAR(energies[0], energies[1], 1e-10);
+
+	xacc::unsetOption("mpi-threads");
+	xacc::unsetOption("vqe-use-mpi");
+}
+
+TEST(ComputeEnergyVQETaskTester,checkPartitionByCost) {
+
+	// A contiguous split would put both expensive
+	// terms on the first rank
+	std::vector<double> costs {9, 8, 1, 1, 1, 1, 1, 1};
+	auto owners = partitionByCost(costs, 2);
+	EXPECT_EQ(costs.size(), owners.size());
+	EXPECT_NE(owners[0], owners[1]);
+
+	std::vector<double> loads(2, 0.0);
+	for (int i = 0; i < costs.size(); i++) {
+		loads[owners[i]] += costs[i];
+	}
+	EXPECT_DOUBLE_EQ(12.0, loads[0]);
+	EXPECT_DOUBLE_EQ(11.0, loads[1]);
+}
+
 int main(int argc, char** argv) {
    xacc::Initialize(argc,argv);
    ::testing::InitGoogleTest(&argc, argv);
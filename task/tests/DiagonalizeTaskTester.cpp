@@ -30,6 +30,10 @@
  **********************************************************************************/
 #include <gtest/gtest.h>
 #include "DiagonalizeTask.hpp"
+#include "MatrixFreeDiagonalizeBackend.hpp"
+#include "NumberSector.hpp"
+#include <limits>
+#include <sstream>
 #include "ServiceRegistry.hpp"
 #include "MPIProvider.hpp"
 
@@ -109,6 +113,103 @@ TEST(ComputeEnergyVQETaskTester,checkSimple) {
 
 }
 
+TEST(DiagonalizeTaskTester,checkSparseDiagonalization) {
+
+	// Transverse field Ising chain, with a Y coupling
+	// to get complex matrix elements
+	PauliOperator H;
+	int n = 6;
+	for (int i = 0; i < n - 1; i++) {
+		H += PauliOperator({{i, "Z"}, {i+1, "Z"}}, -1.0);
+		H += PauliOperator({{i, "Y"}, {i+1, "X"}}, 0.25);
+	}
+	for (int i = 0; i < n; i++) {
+		H += PauliOperator({{i, "X"}}, -0.7);
+	}
+
+	EigenDiagonalizeBackend backend;
+	auto dense = backend.diagonalize(H);
+
+	xacc::setOption("diag-sparse", "");
+	auto sparse = backend.diagonalize(H);
+	xacc::unsetOption("diag-sparse");
+
+	EXPECT_NEAR(dense, sparse, 1e-8);
+
+	MatrixFreeDiagonalizeBackend matfree;
+	EXPECT_NEAR(dense, matfree.diagonalize(H), 1e-8);
+
+	// Reference matrix built independently of the
+	// PauliMask path, row by row from bit strings
+	std::uint64_t dim = 1 << n;
+	Eigen::MatrixXcd A = Eigen::MatrixXcd::Zero(dim, dim);
+	for (std::uint64_t row = 0; row < dim; row++) {
+		std::stringstream s;
+		for (int k = n - 1; k >= 0; k--) s << ((row >> k) & 1);
+		for (auto& result : H.computeActionOnBra(s.str())) {
+			A(row, std::stol(result.first, nullptr, 2)) += result.second;
+		}
+	}
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> es(A);
+	EXPECT_NEAR(es.eigenvalues()(0), sparse, 1e-8);
+}
+
+TEST(DiagonalizeTaskTester,checkH2GroundState) {
+
+	// H2 / sto-3g at 0.7414 Angstrom after Jordan-Wigner
+	PauliOperator H;
+	H.fromString("(-0.0988349,0) + (0.171201,0) Z0 + (0.171201,0) Z1 + "
+			"(-0.222796,0) Z2 + (-0.222796,0) Z3 + (0.168623,0) Z0 Z1 + "
+			"(0.120546,0) Z0 Z2 + (0.165868,0) Z0 Z3 + (0.165868,0) Z1 Z2 + "
+			"(0.120546,0) Z1 Z3 + (0.174349,0) Z2 Z3 + "
+			"(-0.0453219,0) X0 X1 Y2 Y3 + (0.0453219,0) X0 Y1 Y2 X3 + "
+			"(0.0453219,0) Y0 X1 X2 Y3 + (-0.0453219,0) Y0 Y1 X2 X3");
+
+	EigenDiagonalizeBackend backend;
+	EXPECT_NEAR(-1.13727, backend.diagonalize(H), 1e-5);
+
+	xacc::setOption("diag-sparse", "");
+	EXPECT_NEAR(-1.13727, backend.diagonalize(H), 1e-5);
+	xacc::unsetOption("diag-sparse");
+
+	MatrixFreeDiagonalizeBackend matfree;
+	EXPECT_NEAR(-1.13727, matfree.diagonalize(H), 1e-5);
+}
+
+TEST(DiagonalizeTaskTester,checkNumberSymmetry) {
+
+	// Number conserving XY chain with on-site terms
+	PauliOperator H;
+	int n = 6;
+	for (int i = 0; i < n - 1; i++) {
+		H += PauliOperator({{i, "X"}, {i+1, "X"}}, 0.5);
+		H += PauliOperator({{i, "Y"}, {i+1, "Y"}}, 0.5);
+		H += PauliOperator({{i, "Z"}, {i+1, "Z"}}, 0.3);
+	}
+	H += PauliOperator({{0, "Z"}}, 0.7);
+
+	EigenDiagonalizeBackend backend;
+	auto full = backend.diagonalize(H);
+
+	xacc::setOption("diag-number-symmetry", "");
+	double lowest = std::numeric_limits<double>::max();
+	for (int k = 0; k <= n; k++) {
+		xacc::setOption("n-electrons", std::to_string(k));
+		lowest = std::min(lowest, backend.diagonalize(H));
+	}
+	xacc::unsetOption("diag-number-symmetry");
+
+	EXPECT_NEAR(full, lowest, 1e-8);
+
+	for (auto bk : {false, true}) {
+		NumberSector sector(8, 3, bk);
+		EXPECT_EQ(56, sector.size());
+		for (std::uint64_t i = 0; i < sector.size(); i++) {
+			EXPECT_EQ(i, sector.index(sector.state(i)));
+		}
+	}
+}
+
 int main(int argc, char** argv) {
    xacc::Initialize(argc,argv);
    ::testing::InitGoogleTest(&argc, argv);
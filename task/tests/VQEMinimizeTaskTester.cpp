@@ -30,16 +30,12 @@
  **********************************************************************************/
 #include <gtest/gtest.h>
 #include "VQEMinimizeTask.hpp"
+#include "ParameterShiftVQEBackend.hpp"
 #include "MPIProvider.hpp"
 #include <iostream>
 using namespace xacc::vqe;
 
-TEST(VQEMinimizeTaskTester,checkSimple) {
-
-	auto argc = xacc::getArgc();
-	auto argv = xacc::getArgv();
-
-	const std::string src = R"src(__qpu__ kernel() {
+const std::string h2Src = R"src(__qpu__ kernel() {
    0.7137758743754461
    -1.252477303982147 0 1 0 0
    0.337246551663004 0 1 1 1 1 0 0 0
@@ -71,6 +67,11 @@ TEST(VQEMinimizeTaskTester,checkSimple) {
    -0.4759344611440753 3 1 3 0
 })src";
 
+TEST(VQEMinimizeTaskTester,checkSimple) {
+
+	auto argc = xacc::getArgc();
+	auto argv = xacc::getArgv();
+
 	std::shared_ptr<MPIProvider> provider;
 	if (xacc::hasService<MPIProvider>("boost-mpi")) {
 		provider = xacc::getService<MPIProvider>("boost-mpi");
@@ -90,7 +91,7 @@ TEST(VQEMinimizeTaskTester,checkSimple) {
 		auto accelerator = xacc::getAccelerator("tnqvm");
         auto b = accelerator->createBuffer("q",4);
 
-		auto program = std::make_shared<VQEProgram>(accelerator, src, world);
+		auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
         program->setGlobalBuffer(b);
 		program->build();
 
@@ -106,6 +107,47 @@ TEST(VQEMinimizeTaskTester,checkSimple) {
 
 }
 
+TEST(VQEMinimizeTaskTester,checkParameterShift) {
+
+	auto provider = xacc::getService<MPIProvider>("no-mpi");
+	provider->initialize();
+	auto world = provider->getCommunicator();
+	xacc::setOption("n-qubits", "4");
+	xacc::setOption("n-electrons", "2");
+	xacc::setOption("vqe-task", "compute-energy");
+	xacc::setOption("vqe-exact-expectation", "");
+
+	auto accelerator = xacc::getAccelerator("vqe-dummy");
+	auto program = std::make_shared<VQEProgram>(accelerator, h2Src, world);
+	program->setGlobalBuffer(std::make_shared<AcceleratorBuffer>("q", 4));
+	program->build();
+
+	ParameterShiftVQEBackend backend;
+	backend.setProgram(program);
+
+	Eigen::VectorXd parameters = Eigen::VectorXd::Zero(2);
+	auto result = backend.minimize(parameters);
+	EXPECT_NEAR(result.energy, -1.13727042207, 1e-4);
+
+	// Compare the analytic gradient to central differences
+	Eigen::VectorXd x(2), grad(2);
+	x << 0.3, -0.2;
+	backend.gradient(x, grad);
+	const double h = 1e-4;
+	for (int k = 0; k < 2; k++) {
+		Eigen::VectorXd xp = x, xm = x;
+		xp(k) += h;
+		xm(k) -= h;
+		auto fd = (backend.value(xp) - backend.value(xm)) / (2 * h);
+		EXPECT_NEAR(grad(k), fd, 1e-5);
+	}
+
+	xacc::unsetOption("n-qubits");
+	xacc::unsetOption("n-electrons");
+	xacc::unsetOption("vqe-task");
+	xacc::unsetOption("vqe-exact-expectation");
+}
+
 int main(int argc, char** argv) {
    xacc::Initialize(argc,argv);
    ::testing::InitGoogleTest(&argc, argv);
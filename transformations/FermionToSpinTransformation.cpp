@@ -0,0 +1,228 @@
+#include "FermionToSpinTransformation.hpp"
+#include "FermionOperator.hpp"
+#include "MPIProvider.hpp"
+#include "xacc_service.hpp"
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+namespace xacc {
+namespace vqe {
+
+BinaryPauliOperator FermionToSpinTransformation::mapInstructions(
+		FermionKernel& kernel,
+		std::function<void(InstPtr, BinaryPauliOperator&)> mapTerm) {
+
+	BinaryPauliOperator result;
+	if (!simplifyTerms || xacc::optionExists("fermion-no-simplify")) {
+		result = mapTerms(kernel, mapTerm);
+	} else {
+		// Merge, normal order, threshold and fold the fermion terms
+		// so that fewer of them have to be mapped
+		double tol = xacc::optionExists("fermion-threshold") ?
+				std::stod(xacc::getOption("fermion-threshold")) : 1e-12;
+		FermionOperator op(kernel);
+		op.threshold(tol);
+		op.foldHermitian(tol);
+
+		result = mapTerms(*op.toKernel(kernel.name()), mapTerm);
+		auto folded = mapTerms(*op.toKernel(kernel.name(), true), mapTerm);
+		result += folded;
+		result += folded.hermitianConjugate();
+	}
+
+	weights = weightReport(result);
+	if (xacc::optionExists("fermion-weight-report")) {
+		xacc::info(name() + " weights: " + weights.toString());
+	}
+	return result;
+}
+
+FermionToSpinTransformation::PauliWeightReport FermionToSpinTransformation::weightReport(
+		const BinaryPauliOperator& op) {
+	PauliWeightReport report;
+	std::size_t totalWeight = 0;
+	for (auto& kv : op.getTerms()) {
+		auto w = kv.first.first.weight();
+		if (w == 0 || std::abs(kv.second) < 1e-12) {
+			continue;
+		}
+		report.nTerms++;
+		totalWeight += w;
+		report.maxWeight = std::max(report.maxWeight, w);
+		report.cnotCount += 2 * (w - 1);
+	}
+	if (report.nTerms) {
+		report.averageWeight = (double) totalWeight / report.nTerms;
+	}
+	return report;
+}
+
+BinaryPauliOperator FermionToSpinTransformation::sPlus(const int site) {
+	BinaryPauliTerm sx, sy;
+	sx.set(site, 'X');
+	sy.set(site, 'Y');
+	BinaryPauliOperator op(sx, 0.5);
+	op.addTerm(sy, std::complex<double>(0, -0.5));
+	return op;
+}
+
+BinaryPauliOperator FermionToSpinTransformation::sMinus(const int site) {
+	BinaryPauliTerm sx, sy;
+	sx.set(site, 'X');
+	sy.set(site, 'Y');
+	BinaryPauliOperator op(sx, 0.5);
+	op.addTerm(sy, std::complex<double>(0, 0.5));
+	return op;
+}
+
+void FermionToSpinTransformation::addLadderProduct(InstPtr f,
+		const std::vector<BinaryPauliTerm>& c,
+		const std::vector<BinaryPauliTerm>& d,
+		BinaryPauliOperator& accumulator) {
+
+	static const std::complex<double> iPowers[4] = {
+			{1.0, 0.0}, {0.0, 1.0}, {-1.0, 0.0}, {0.0, -1.0}};
+
+	// Get the creation or annihilation sites
+	auto termSites = f->bits();
+
+	// Get the params indicating if termSite is creation or annihilation
+	auto params = f->getParameters();
+
+	auto coeff = params[params.size() - 2].as<std::complex<double>>();
+	auto fermionVar = params[params.size() - 1].as<std::string>();
+
+	int nOps = termSites.size();
+	for (auto site : termSites) {
+		if (site >= c.size()) {
+			xacc::error("Invalid fermion site " + std::to_string(site)
+					+ " for " + std::to_string(c.size()) + " qubits.");
+		}
+	}
+
+	// Expand the product by picking c or d from every factor
+	for (int choice = 0; choice < (1 << nOps); choice++) {
+		BinaryPauliTerm product, tmp;
+		auto termCoeff = coeff;
+		int k = 0;
+		for (int i = 0; i < nOps; i++) {
+			auto index = termSites[i];
+			if ((choice >> i) & 1) {
+				termCoeff *= params[i].as<int>() ? std::complex<double>(0, -.5) :
+						std::complex<double>(0, .5);
+				k += product.multiply(d[index], tmp);
+			} else {
+				termCoeff *= .5;
+				k += product.multiply(c[index], tmp);
+			}
+			product = tmp;
+		}
+		accumulator.addTerm(product, iPowers[k % 4] * termCoeff, fermionVar);
+	}
+}
+
+BinaryPauliOperator FermionToSpinTransformation::mapTerms(
+		FermionKernel& kernel,
+		std::function<void(InstPtr, BinaryPauliOperator&)> mapTerm) {
+
+	// Terms of a columnar kernel are loaded into one reused
+	// FermionInstruction per thread instead of being materialized
+	auto columnar = dynamic_cast<ColumnarFermionKernel*>(&kernel);
+	std::vector<InstPtr> instVec;
+	if (!columnar) {
+		auto instructions = kernel.getInstructions();
+		instVec.assign(instructions.begin(), instructions.end());
+	}
+	const int nTerms = columnar ? columnar->nInstructions() : instVec.size();
+
+	// Split the instructions across MPI ranks if requested
+	std::shared_ptr<Communicator> comm;
+	if (xacc::optionExists("fermion-transformation-mpi")) {
+		auto provider = xacc::hasService<MPIProvider>("boost-mpi") ?
+				xacc::getService<MPIProvider>("boost-mpi") :
+				xacc::getService<MPIProvider>("no-mpi");
+		comm = provider->getCommunicator();
+		if (!comm) {
+			provider->initialize();
+			comm = provider->getCommunicator();
+		}
+	}
+
+	int rank = comm ? comm->rank() : 0, nRanks = comm ? comm->size() : 1;
+	int myStart = rank * nTerms / nRanks;
+	int myEnd = (rank + 1) * nTerms / nRanks;
+	int nLocal = myEnd - myStart;
+
+	int nThreads = 1;
+	if (runParallel) {
+		nThreads = xacc::optionExists("fermion-transformation-threads") ?
+				std::stoi(xacc::getOption("fermion-transformation-threads")) :
+				std::thread::hardware_concurrency();
+		// Not worth spawning threads for a handful of terms
+		nThreads = std::max(1, std::min(nThreads, nLocal / 64));
+	}
+
+	std::vector<BinaryPauliOperator> partials(nThreads);
+	auto mapChunk = [&](const int t) {
+		int start = myStart + t * nLocal / nThreads;
+		int end = myStart + (t + 1) * nLocal / nThreads;
+		if (columnar) {
+			auto& columns = columnar->getColumns();
+			auto inst = std::make_shared<FermionInstruction>(
+					std::vector<std::pair<int, int>> { });
+			for (int z = start; z < end; ++z) {
+				columns.load(z, *inst);
+				mapTerm(inst, partials[t]);
+			}
+		} else {
+			for (int z = start; z < end; ++z) {
+				mapTerm(instVec[z], partials[t]);
+			}
+		}
+	};
+
+	if (nThreads == 1) {
+		mapChunk(0);
+	} else {
+		std::vector<std::thread> threads;
+		for (int t = 0; t < nThreads; t++) {
+			threads.push_back(std::thread(mapChunk, t));
+		}
+		for (auto& t : threads) {
+			t.join();
+		}
+
+		// Pairwise tree reduction of the thread-local results
+		for (int stride = 1; stride < nThreads; stride *= 2) {
+			threads.clear();
+			for (int t = 0; t + stride < nThreads; t += 2 * stride) {
+				threads.push_back(std::thread([&partials, t, stride]() {
+					partials[t] += partials[t + stride];
+					partials[t + stride].clear();
+				}));
+			}
+			for (auto& t : threads) {
+				t.join();
+			}
+		}
+	}
+
+	if (nRanks > 1) {
+		// Serialized terms are self delimiting, so the
+		// concatenation of all ranks' bytes can be added at once
+		auto bytes = partials[0].toBytes();
+		std::vector<char> myBytes(bytes.begin(), bytes.end()), all;
+		std::vector<int> counts;
+		comm->allGatherv(myBytes, all, counts);
+
+		BinaryPauliOperator global;
+		global.addBytes(std::string(all.begin(), all.end()));
+		return global;
+	}
+
+	return partials[0];
+}
+
+}
+}
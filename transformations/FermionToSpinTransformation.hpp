@@ -35,8 +35,11 @@
 #include "FermionKernel.hpp"
 #include "FermionIR.hpp"
 #include "PauliOperator.hpp"
+#include "BinaryPauliOperator.hpp"
 
 #include "XACC.hpp"
+#include <functional>
+#include <sstream>
 
 using namespace xacc::quantum;
 
@@ -62,10 +65,105 @@ public:
 		return PauliOperator();
 	}
 
+	/**
+	 * If true, FermionInstructions are mapped on multiple
+	 * threads (see mapInstructions).
+	 */
 	bool runParallel = true;
 
+	/**
+	 * If true, terms are merged, normal ordered and folded before
+	 * they are mapped (see mapInstructions). Mappings whose term
+	 * maps depend on the order of the given operators turn it off.
+	 */
+	bool simplifyTerms = true;
+
+	/**
+	 * Pauli weight statistics of a mapped Hamiltonian. Each term
+	 * of weight w costs 2(w-1) CNOTs in its Trotter exponential
+	 * (a CNOT ladder), which is summed up in cnotCount.
+	 */
+	struct PauliWeightReport {
+		std::size_t nTerms = 0;
+		double averageWeight = 0.0;
+		int maxWeight = 0;
+		std::size_t cnotCount = 0;
+
+		const std::string toString() const {
+			std::stringstream ss;
+			ss << nTerms << " terms, average weight " << averageWeight
+					<< ", max weight " << maxWeight << ", estimated CNOTs "
+					<< cnotCount;
+			return ss.str();
+		}
+	};
+
+	static PauliWeightReport weightReport(const BinaryPauliOperator& op);
+
+	/**
+	 * Return the weight statistics of the last mapping.
+	 */
+	const PauliWeightReport& getWeightReport() const {
+		return weights;
+	}
+
 protected:
 
+	/**
+	 * Map every FermionInstruction of the given kernel with mapTerm,
+	 * which adds the spin representation of the instruction to the
+	 * provided accumulator, and return the sum of all mapped terms.
+	 *
+	 * If simplifyTerms is set and fermion-no-simplify is not, the
+	 * instructions are first collected in a FermionOperator, which
+	 * merges duplicate terms, normal orders them, drops terms below
+	 * fermion-threshold (default 1e-12) and folds hermitian conjugate
+	 * pairs. Of every folded pair only one term is mapped, the other
+	 * one is added as the hermitian conjugate of the mapped result.
+	 *
+	 * If runParallel is set, the instructions are split into contiguous
+	 * chunks mapped on separate threads into thread-local accumulators
+	 * that are then combined with a pairwise tree reduction. The number
+	 * of threads is given by fermion-transformation-threads (default is
+	 * the hardware concurrency). If fermion-transformation-mpi is set,
+	 * the instructions are first split across MPI ranks and the rank
+	 * results are all-gathered, so every rank holds the full result.
+	 *
+	 * The weight statistics of the result are kept (see getWeightReport)
+	 * and printed if fermion-weight-report is set.
+	 */
+	BinaryPauliOperator mapInstructions(FermionKernel& kernel,
+			std::function<void(InstPtr, BinaryPauliOperator&)> mapTerm);
+
+	/**
+	 * Map the instructions of the kernel as they are (see mapInstructions).
+	 */
+	BinaryPauliOperator mapTerms(FermionKernel& kernel,
+			std::function<void(InstPtr, BinaryPauliOperator&)> mapTerm);
+
+	/**
+	 * Add the image of the ladder operator product f to the
+	 * accumulator, for an encoding given by the Majorana operators
+	 * c_i and d_i of every mode, with a_i = (c_i + i d_i) / 2 and
+	 * a^dag_i = (c_i - i d_i) / 2.
+	 */
+	static void addLadderProduct(InstPtr f,
+			const std::vector<BinaryPauliTerm>& c,
+			const std::vector<BinaryPauliTerm>& d,
+			BinaryPauliOperator& accumulator);
+
+	/**
+	 * Return the spin raising operator (X - iY) / 2 on the given site.
+	 */
+	static BinaryPauliOperator sPlus(const int site);
+
+	/**
+	 * Return the spin lowering operator (X + iY) / 2 on the given site.
+	 */
+	static BinaryPauliOperator sMinus(const int site);
+
+	PauliWeightReport weights;
+
 	/**
 	 * Reference to the transformation result.
 	 */
@@ -32,6 +32,8 @@
 #include "BravyiKitaevIRTransformation.hpp"
 #include "EfficientJW.hpp"
 #include "LongRangeJW.hpp"
+#include "ParityIRTransformation.hpp"
+#include "TernaryTreeIRTransformation.hpp"
 
 #include "cppmicroservices/BundleActivator.h"
 #include "cppmicroservices/BundleContext.h"
@@ -60,6 +62,8 @@ public:
 		auto c3 = std::make_shared<xacc::vqe::BravyiKitaevIRTransformation>();
 		auto c4 = std::make_shared<xacc::vqe::EfficientJW>();
 		auto c5 = std::make_shared<xacc::vqe::LongRangeJW>();
+		auto c6 = std::make_shared<xacc::vqe::ParityIRTransformation>();
+		auto c7 = std::make_shared<xacc::vqe::TernaryTreeIRTransformation>();
 
 		context.RegisterService<xacc::IRTransformation>(c);
 		context.RegisterService<xacc::vqe::FermionToSpinTransformation>(c);
@@ -70,6 +74,11 @@ public:
 		context.RegisterService<xacc::vqe::FermionToSpinTransformation>(c5);
 		context.RegisterService<xacc::IRTransformation>(c5);
 
+		context.RegisterService<xacc::IRTransformation>(c6);
+		context.RegisterService<xacc::vqe::FermionToSpinTransformation>(c6);
+		context.RegisterService<xacc::IRTransformation>(c7);
+		context.RegisterService<xacc::vqe::FermionToSpinTransformation>(c7);
+
 	}
 
 	/**
@@ -0,0 +1,128 @@
+#ifndef VQE_TRANSFORMATION_BK_BRAVYIKITAEVMASKS_HPP_
+#define VQE_TRANSFORMATION_BK_BRAVYIKITAEVMASKS_HPP_
+
+#include "BinaryPauliOperator.hpp"
+#include <mutex>
+
+namespace xacc {
+namespace vqe {
+
+/**
+ * BravyiKitaevMasks holds the Bravyi-Kitaev image of every ladder
+ * operator on nQubits qubits as two bit-packed Pauli strings,
+ *
+ *   a^dag_i = (c_i - i d_i) / 2,  a_i = (c_i + i d_i) / 2,
+ *
+ * with c_i = X_U(i) X_i Z_P(i) and d_i = X_U(i) Y_i Z_R(i), where U, P
+ * and R are the update, parity and remainder sets of the FenwickTree.
+ *
+ * The sets are computed from a parent array built with the same
+ * interval splitting as the FenwickTree, without allocating nodes
+ * or sets. Masks are cached per qubit count, get() is thread safe.
+ */
+class BravyiKitaevMasks {
+
+protected:
+
+	std::vector<BinaryPauliTerm> cTerms;
+	std::vector<BinaryPauliTerm> dTerms;
+
+public:
+
+	BravyiKitaevMasks(const int nQubits) :
+			cTerms(nQubits), dTerms(nQubits) {
+		if (nQubits <= 0) {
+			return;
+		}
+		if (nQubits > 64 * BinaryPauliTerm::NWORDS) {
+			xacc::error("BravyiKitaevMasks supports at most "
+					+ std::to_string(64 * BinaryPauliTerm::NWORDS) + " qubits.");
+		}
+
+		// Node pvt = (idx1 + idx2) / 2 of the interval [idx1, idx2]
+		// is a child of the interval's parent, its left part [idx1, pvt]
+		// hangs below pvt and its right part below the same parent
+		std::vector<int> parent(nQubits, -1);
+		std::vector<std::pair<std::pair<int, int>, int>> intervals {
+				{ { 0, nQubits - 1 }, nQubits - 1 } };
+		while (!intervals.empty()) {
+			auto interval = intervals.back();
+			intervals.pop_back();
+			int idx1 = interval.first.first, idx2 = interval.first.second;
+			if (idx1 < idx2) {
+				auto pvt = (idx1 + idx2) >> 1;
+				parent[pvt] = interval.second;
+				intervals.push_back({ { idx1, pvt }, pvt });
+				intervals.push_back({ { pvt + 1, idx2 }, interval.second });
+			}
+		}
+
+		for (int i = 0; i < nQubits; i++) {
+			auto& c = cTerms[i];
+			auto& d = dTerms[i];
+
+			// Children of i are in the parity set
+			for (int j = 0; j < i; j++) {
+				if (parent[j] == i) {
+					c.set(j, 'Z');
+				}
+			}
+
+			// Ancestors are the update set, their children
+			// below i are the remainder set
+			for (int a = parent[i]; a >= 0; a = parent[a]) {
+				c.set(a, 'X');
+				d.set(a, 'X');
+				for (int j = 0; j < i; j++) {
+					if (parent[j] == a) {
+						c.set(j, 'Z');
+						d.set(j, 'Z');
+					}
+				}
+			}
+
+			c.set(i, 'X');
+			d.set(i, 'Y');
+		}
+	}
+
+	const int size() const {
+		return cTerms.size();
+	}
+
+	const BinaryPauliTerm& c(const int i) const {
+		return cTerms[i];
+	}
+
+	const BinaryPauliTerm& d(const int i) const {
+		return dTerms[i];
+	}
+
+	const std::vector<BinaryPauliTerm>& getCTerms() const {
+		return cTerms;
+	}
+
+	const std::vector<BinaryPauliTerm>& getDTerms() const {
+		return dTerms;
+	}
+
+	/**
+	 * Return the (cached) masks for the given number of qubits.
+	 */
+	static std::shared_ptr<const BravyiKitaevMasks> get(const int nQubits) {
+		static std::mutex mutex;
+		static std::map<int, std::shared_ptr<const BravyiKitaevMasks>> cache;
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = cache.find(nQubits);
+		if (it == cache.end()) {
+			it = cache.insert( { nQubits, std::make_shared<BravyiKitaevMasks>(
+					nQubits) }).first;
+		}
+		return it->second;
+	}
+};
+
+}
+}
+
+#endif
@@ -43,6 +43,11 @@ class EfficientJW: public FermionToSpinTransformation {
 
 public:
 
+	EfficientJW() {
+		// The term maps assume the given operator order
+		simplifyTerms = false;
+	}
+
 	/**
 	 * Transform a FermionIR instance to a GateQIR instance.
 	 *
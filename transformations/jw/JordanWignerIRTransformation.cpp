@@ -1,27 +1,134 @@
 #include "JordanWignerIRTransformation.hpp"
 #include "XACC.hpp"
+#include "BinaryPauliOperator.hpp"
+#include <algorithm>
 #include <ctime>
 
 namespace xacc {
 namespace vqe {
 
+namespace {
+
+const std::complex<double> iPowers[4] = { { 1.0, 0.0 }, { 0.0, 1.0 }, {
+		-1.0, 0.0 }, { 0.0, -1.0 } };
+
+/**
+ * The Jordan-Wigner images Z_0..Z_{i-1} X_i and Z_0..Z_{i-1} Y_i
+ * of the ladder operators on every site, built once.
+ */
+struct LadderTable {
+	BinaryPauliTerm xTerms[64 * BinaryPauliTerm::NWORDS];
+	BinaryPauliTerm yTerms[64 * BinaryPauliTerm::NWORDS];
+
+	LadderTable() {
+		BinaryPauliTerm zString;
+		for (int i = 0; i < 64 * BinaryPauliTerm::NWORDS; i++) {
+			xTerms[i] = zString;
+			xTerms[i].set(i, 'X');
+			yTerms[i] = zString;
+			yTerms[i].set(i, 'Y');
+			zString.set(i, 'Z');
+		}
+	}
+};
+
+const LadderTable& ladderTable() {
+	static const LadderTable table;
+	return table;
+}
+
+/**
+ * Add coeff * a^dag_p a_q, p != q, which is
+ * (X_p X_q + Y_p Y_q + i X_p Y_q - i Y_p X_q) / 4 times the
+ * Z string strictly between p and q.
+ */
+void addHopping(const int p, const int q, const std::complex<double> coeff,
+		const std::string& var, BinaryPauliOperator& accumulator) {
+	BinaryPauliTerm zString;
+	for (int j = std::min(p, q) + 1; j < std::max(p, q); j++) {
+		zString.set(j, 'Z');
+	}
+	const char paulis[4][2] = { { 'X', 'X' }, { 'Y', 'Y' }, { 'X', 'Y' }, {
+			'Y', 'X' } };
+	const std::complex<double> coeffs[4] = { 0.25, 0.25, { 0.0, 0.25 }, { 0.0,
+			-0.25 } };
+	for (int t = 0; t < 4; t++) {
+		auto term = zString;
+		term.set(p, paulis[t][0]);
+		term.set(q, paulis[t][1]);
+		accumulator.addTerm(term, coeffs[t] * coeff, var);
+	}
+}
+
+/**
+ * If every site of the term carries one creation operator followed
+ * (not necessarily directly) by one annihilation operator, the term
+ * is sign * n_s1 n_s2 ... Return the sign, or 0 if the term has
+ * another form.
+ */
+int numberProductSign(const std::vector<int>& sites,
+		const std::vector<InstructionParameter>& params) {
+	int n = sites.size();
+	if (n % 2) {
+		return 0;
+	}
+	for (int i = 0; i < n; i++) {
+		int matches = 0;
+		for (int j = 0; j < n; j++) {
+			if (sites[j] == sites[i]) {
+				matches++;
+				if (j > i && params[i].as<int>() == params[j].as<int>()) {
+					return 0;
+				}
+				if (j > i && !params[i].as<int>()) {
+					return 0;
+				}
+			}
+		}
+		if (matches != 2) {
+			return 0;
+		}
+	}
+
+	// Apply the term to the state with all its sites occupied,
+	// each operator on site s picks up (-1)^(occupied sites below s)
+	std::vector<int> occupied;
+	for (int i = 0; i < n; i++) {
+		if (params[i].as<int>()) {
+			occupied.push_back(sites[i]);
+		}
+	}
+	int sign = 1;
+	for (int i = n - 1; i >= 0; i--) {
+		for (auto o : occupied) {
+			if (o < sites[i]) {
+				sign = -sign;
+			}
+		}
+		if (params[i].as<int>()) {
+			occupied.push_back(sites[i]);
+		} else {
+			occupied.erase(std::find(occupied.begin(), occupied.end(), sites[i]));
+		}
+	}
+	return sign;
+}
+
+}
+
 PauliOperator JordanWignerIRTransformation::transform(FermionKernel& kernel) {
-	int myStart = 0;
-	int myEnd = kernel.nInstructions();
 
 	result.clear();
 
-	fermionKernel = std::make_shared<FermionKernel>(kernel);
-
-	auto instructions = kernel.getInstructions();
-	auto instVec = std::vector<InstPtr>(instructions.begin(), instructions.end());
+	fermionKernel = kernel.clone();
 
 	auto start = std::clock();
 
-	// Loop over all Fermionic terms...
-	for (int z = myStart; z < myEnd; ++z) {
+	// Map all Fermionic terms...
+	auto binaryResult = mapInstructions(kernel,
+			[](InstPtr f, BinaryPauliOperator& accumulator) {
 
-		auto f = instVec[z];
+		auto& table = ladderTable();
 
 		// Get the creation or annihilation sites
 		auto termSites = f->bits();
@@ -32,27 +139,77 @@ PauliOperator JordanWignerIRTransformation::transform(FermionKernel& kernel) {
 		auto coeff = params[f->nParameters() - 2].as<std::complex<double>>();
 		auto fermionVar = params[f->nParameters() - 1].as<std::string>();
 
-		PauliOperator current(coeff, fermionVar);
-		for (int i = 0; i < termSites.size(); i++) {
-			std::map<int, std::string> zs;
-			auto isCreation = params[i].as<int>();
-
-			int index = termSites[i];
+		int nOps = termSites.size();
+		for (auto site : termSites) {
+			if (site >= 64 * BinaryPauliTerm::NWORDS) {
+				xacc::error("JordanWignerIRTransformation supports at most "
+						+ std::to_string(64 * BinaryPauliTerm::NWORDS) + " qubits.");
+			}
+		}
 
-			std::complex<double> ycoeff =
-					isCreation ?
-							std::complex<double>(0, -.5) :
-							std::complex<double>(0, .5), xcoeff(.5, 0);
+		// Hopping terms a^dag_p a_q and a_q a^dag_p = -a^dag_p a_q
+		if (nOps == 2 && termSites[0] != termSites[1]
+				&& params[0].as<int>() != params[1].as<int>()) {
+			if (params[0].as<int>()) {
+				addHopping(termSites[0], termSites[1], coeff, fermionVar,
+						accumulator);
+			} else {
+				addHopping(termSites[1], termSites[0], -coeff, fermionVar,
+						accumulator);
+			}
+			return;
+		}
 
-			for (int j = 0; j < index; j++) zs.emplace(std::make_pair(j,"Z"));
+		// Number, Coulomb and exchange terms, sign * n_s1 .. n_sm with
+		// n_s = (I - Z_s) / 2, a sum over all subsets of Z_s
+		auto sign = numberProductSign(termSites, params);
+		if (sign) {
+			std::vector<int> numberSites;
+			for (int i = 0; i < nOps; i++) {
+				if (params[i].as<int>()) {
+					numberSites.push_back(termSites[i]);
+				}
+			}
+			int m = numberSites.size();
+			auto termCoeff = coeff * (double) sign / (double) (1 << m);
+			for (int subset = 0; subset < (1 << m); subset++) {
+				BinaryPauliTerm term;
+				for (int i = 0; i < m; i++) {
+					if ((subset >> i) & 1) {
+						term.set(numberSites[i], 'Z');
+					}
+				}
+				accumulator.addTerm(term,
+						__builtin_popcount(subset) % 2 ? -termCoeff : termCoeff,
+						fermionVar);
+			}
+			return;
+		}
 
-			current *= PauliOperator(zs)
-					* (PauliOperator( { { index, "X" } }, xcoeff)
-							+ PauliOperator( { { index, "Y" } }, ycoeff));
+		// Everything else, each ladder operator is (X -+ i Y) / 2
+		// times a Z string, expand the product by picking the X or
+		// Y term from every factor
+		for (int choice = 0; choice < (1 << nOps); choice++) {
+			BinaryPauliTerm product, tmp;
+			auto termCoeff = coeff;
+			int k = 0;
+			for (int i = 0; i < nOps; i++) {
+				auto index = termSites[i];
+				if ((choice >> i) & 1) {
+					termCoeff *= params[i].as<int>() ? std::complex<double>(0, -.5) :
+							std::complex<double>(0, .5);
+					k += product.multiply(table.yTerms[index], tmp);
+				} else {
+					termCoeff *= .5;
+					k += product.multiply(table.xTerms[index], tmp);
+				}
+				product = tmp;
+			}
+			accumulator.addTerm(product, iPowers[k % 4] * termCoeff, fermionVar);
 		}
+	});
 
-		result += current;
-	}
+	result = binaryResult.toPauliOperator();
 
 //	std::cout << (std::clock() - start) / (double) (CLOCKS_PER_SEC) << "\n";
 
@@ -43,6 +43,11 @@ class LongRangeJW: public FermionToSpinTransformation {
 
 public:
 
+	LongRangeJW() {
+		// The term maps assume the given operator order
+		simplifyTerms = false;
+	}
+
 	/**
 	 * Transform a FermionIR instance to a GateQIR instance.
 	 *
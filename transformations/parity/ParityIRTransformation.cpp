@@ -0,0 +1,55 @@
+#include "ParityIRTransformation.hpp"
+#include "XACC.hpp"
+
+namespace xacc {
+namespace vqe {
+
+void ParityIRTransformation::majoranas(const int nQubits,
+		std::vector<BinaryPauliTerm>& c, std::vector<BinaryPauliTerm>& d) {
+	if (nQubits > 64 * BinaryPauliTerm::NWORDS) {
+		xacc::error("ParityIRTransformation supports at most "
+				+ std::to_string(64 * BinaryPauliTerm::NWORDS) + " qubits.");
+	}
+
+	c.assign(nQubits, BinaryPauliTerm());
+	d.assign(nQubits, BinaryPauliTerm());
+	for (int i = 0; i < nQubits; i++) {
+		for (int j = i + 1; j < nQubits; j++) {
+			c[i].set(j, 'X');
+			d[i].set(j, 'X');
+		}
+		if (i > 0) {
+			c[i].set(i - 1, 'Z');
+		}
+		c[i].set(i, 'X');
+		d[i].set(i, 'Y');
+	}
+}
+
+PauliOperator ParityIRTransformation::transform(FermionKernel& kernel) {
+	result.clear();
+
+	int nQubits = std::stoi(xacc::getOption("n-qubits"));
+	fermionKernel = kernel.clone();
+
+	std::vector<BinaryPauliTerm> c, d;
+	majoranas(nQubits, c, d);
+
+	// Map all Fermionic terms...
+	auto binaryResult = mapInstructions(kernel,
+			[&c, &d](InstPtr f, BinaryPauliOperator& accumulator) {
+		addLadderProduct(f, c, d, accumulator);
+	});
+
+	result = binaryResult.toPauliOperator();
+	return result;
+}
+
+std::shared_ptr<IR> ParityIRTransformation::transform(
+		std::shared_ptr<IR> ir) {
+	auto fermiKernel = ir->getKernels()[0];
+	return transform(*std::dynamic_pointer_cast<FermionKernel>(fermiKernel)).toXACCIR();
+}
+
+}
+}
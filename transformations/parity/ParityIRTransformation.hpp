@@ -0,0 +1,84 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef VQE_IR_PARITYIRTRANSFORMATION_HPP_
+#define VQE_IR_PARITYIRTRANSFORMATION_HPP_
+
+#include "FermionToSpinTransformation.hpp"
+
+namespace xacc {
+
+namespace vqe {
+
+/**
+ * The ParityIRTransformation maps fermion terms to spin terms with
+ * the parity encoding, where qubit j stores the parity of the
+ * occupations of modes 0..j. The Majorana operators of mode i are
+ *
+ *   c_i = Z_{i-1} X_i X_{i+1} .. X_{n-1},  d_i = Y_i X_{i+1} .. X_{n-1},
+ *
+ * so occupation sign strings become a single Z and the X string
+ * updates the parities above i.
+ */
+class ParityIRTransformation: public FermionToSpinTransformation {
+
+public:
+
+	/**
+	 * Compute the Majorana operators c_i, d_i of all modes.
+	 */
+	static void majoranas(const int nQubits, std::vector<BinaryPauliTerm>& c,
+			std::vector<BinaryPauliTerm>& d);
+
+	/**
+	 * Transform a FermionIR instance to a GateQIR instance.
+	 *
+	 * @param ir
+	 * @return
+	 */
+	virtual std::shared_ptr<IR> transform(std::shared_ptr<IR> ir);
+	virtual PauliOperator transform(FermionKernel& kernel);
+
+	virtual const std::string name() const {
+		return "parity";
+	}
+
+	virtual const std::string description() const {
+		return "The Parity IR Transformation uses the parity encoding "
+				"to map fermionic instructions to spin-based instructions.";
+	}
+
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "TernaryTreeIRTransformation.hpp"
+#include "XACC.hpp"
+
+namespace xacc {
+namespace vqe {
+
+void TernaryTreeIRTransformation::majoranas(const int nQubits,
+		std::vector<BinaryPauliTerm>& c, std::vector<BinaryPauliTerm>& d) {
+	if (nQubits > 64 * BinaryPauliTerm::NWORDS) {
+		xacc::error("TernaryTreeIRTransformation supports at most "
+				+ std::to_string(64 * BinaryPauliTerm::NWORDS) + " qubits.");
+	}
+
+	const char edges[3] = { 'X', 'Y', 'Z' };
+	c.assign(nQubits, BinaryPauliTerm());
+	d.assign(nQubits, BinaryPauliTerm());
+	for (int u = 0; u < nQubits; u++) {
+
+		// Edges from the root down to u
+		BinaryPauliTerm prefix;
+		for (int v = u; v > 0; v = (v - 1) / 3) {
+			prefix.set((v - 1) / 3, edges[(v - 1) % 3]);
+		}
+
+		c[u] = prefix;
+		d[u] = prefix;
+		c[u].set(u, 'X');
+		d[u].set(u, 'Y');
+		for (int v = 3 * u + 1; v < nQubits; v = 3 * v + 3) {
+			c[u].set(v, 'Z');
+		}
+		for (int v = 3 * u + 2; v < nQubits; v = 3 * v + 3) {
+			d[u].set(v, 'Z');
+		}
+	}
+}
+
+PauliOperator TernaryTreeIRTransformation::transform(FermionKernel& kernel) {
+	result.clear();
+
+	int nQubits = std::stoi(xacc::getOption("n-qubits"));
+	fermionKernel = kernel.clone();
+
+	std::vector<BinaryPauliTerm> c, d;
+	majoranas(nQubits, c, d);
+
+	// Map all Fermionic terms...
+	auto binaryResult = mapInstructions(kernel,
+			[&c, &d](InstPtr f, BinaryPauliOperator& accumulator) {
+		addLadderProduct(f, c, d, accumulator);
+	});
+
+	result = binaryResult.toPauliOperator();
+	return result;
+}
+
+std::shared_ptr<IR> TernaryTreeIRTransformation::transform(
+		std::shared_ptr<IR> ir) {
+	auto fermiKernel = ir->getKernels()[0];
+	return transform(*std::dynamic_pointer_cast<FermionKernel>(fermiKernel)).toXACCIR();
+}
+
+}
+}
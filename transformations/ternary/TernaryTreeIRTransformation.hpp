@@ -0,0 +1,93 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef VQE_IR_TERNARYTREEIRTRANSFORMATION_HPP_
+#define VQE_IR_TERNARYTREEIRTRANSFORMATION_HPP_
+
+#include "FermionToSpinTransformation.hpp"
+
+namespace xacc {
+
+namespace vqe {
+
+/**
+ * The TernaryTreeIRTransformation maps fermion terms to spin terms
+ * with the ternary tree encoding of https://arxiv.org/abs/1910.10746,
+ * whose Majorana operators have weight at most ceil(log3(2n + 1)).
+ *
+ * The qubits form a complete ternary tree in heap order, the children
+ * of qubit u being 3u + 1, 3u + 2 and 3u + 3, reached through an X, Y
+ * and Z edge. Every path from the root to a missing child is a Pauli
+ * string, and the strings pairwise anticommute. Mode u gets the two
+ * paths that leave u through its X and Y edge and then follow Z edges,
+ *
+ *   c_u = P_u X_u Z.., d_u = P_u Y_u Z..,
+ *
+ * with P_u the Paulis of the edges from the root to u, and the
+ * all-Z path is unused. The Z edges act trivially on |0..0>, so
+ * every a_u = P_u (X_u Z.. + i Y_u Z..) / 2 annihilates it and
+ * |0..0> is the vacuum.
+ */
+class TernaryTreeIRTransformation: public FermionToSpinTransformation {
+
+public:
+
+	/**
+	 * Compute the Majorana operators c_i, d_i of all modes.
+	 */
+	static void majoranas(const int nQubits, std::vector<BinaryPauliTerm>& c,
+			std::vector<BinaryPauliTerm>& d);
+
+	/**
+	 * Transform a FermionIR instance to a GateQIR instance.
+	 *
+	 * @param ir
+	 * @return
+	 */
+	virtual std::shared_ptr<IR> transform(std::shared_ptr<IR> ir);
+	virtual PauliOperator transform(FermionKernel& kernel);
+
+	virtual const std::string name() const {
+		return "ternary-tree";
+	}
+
+	virtual const std::string description() const {
+		return "The Ternary Tree IR Transformation uses the ternary tree "
+				"encoding, with Pauli weight log3(2n+1), to map fermionic "
+				"instructions to spin-based instructions.";
+	}
+
+};
+
+}
+
+}
+
+#endif
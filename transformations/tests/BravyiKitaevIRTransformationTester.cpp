@@ -30,6 +30,8 @@
  **********************************************************************************/
 #include <gtest/gtest.h>
 #include "BravyiKitaevIRTransformation.hpp"
+#include "BravyiKitaevMasks.hpp"
+#include "Fenwick.hpp"
 #include "XACC.hpp"
 
 using namespace xacc::vqe;
@@ -176,6 +178,33 @@ TEST(BravyiKitaevIRTransformationTester,checkH2Transform) {
 
 }
 
+TEST(BravyiKitaevIRTransformationTester,checkMasks) {
+
+	for (int n = 1; n < 40; n++) {
+		FenwickTree tree(n);
+		auto masks = BravyiKitaevMasks::get(n);
+		EXPECT_EQ(masks, BravyiKitaevMasks::get(n));
+
+		for (int i = 0; i < n; i++) {
+			BinaryPauliTerm c, d;
+			c.set(i, 'X');
+			d.set(i, 'Y');
+			for (auto p : tree.getParitySet(i)) {
+				c.set(p->index, 'Z');
+			}
+			for (auto r : tree.getRemainderSet(i)) {
+				d.set(r->index, 'Z');
+			}
+			for (auto a : tree.getUpdateSet(i)) {
+				c.set(a->index, 'X');
+				d.set(a->index, 'X');
+			}
+			EXPECT_TRUE(c == masks->c(i));
+			EXPECT_TRUE(d == masks->d(i));
+		}
+	}
+}
+
 int main(int argc, char** argv) {
    xacc::Initialize(argc,argv);
    ::testing::InitGoogleTest(&argc, argv);
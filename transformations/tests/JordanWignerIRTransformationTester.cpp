@@ -30,6 +30,7 @@
  **********************************************************************************/
 #include <gtest/gtest.h>
 #include "JordanWignerIRTransformation.hpp"
+#include "ColumnarFermionKernel.hpp"
 #include "XACC.hpp"
 #include "EfficientJW.cpp"
 #include <regex>
@@ -266,6 +267,91 @@ TEST(JordanWignerTransformationTester,checkEfficientJW) {
 
 }
 
+TEST(JordanWignerTransformationTester,checkParallelTransform) {
+
+	// Build a kernel with enough terms to be
+	// split across several threads
+	auto kernel = std::make_shared<FermionKernel>("foo");
+	int n = 6;
+	for (int p = 0; p < n; p++) {
+		for (int q = 0; q < n; q++) {
+			kernel->addInstruction(std::make_shared<FermionInstruction>(
+					std::vector<std::pair<int, int>> { { p, 1 }, { q, 0 } },
+					0.1 * (p + 1) + 0.01 * q));
+			for (int r = 0; r < n; r++) {
+				kernel->addInstruction(std::make_shared<FermionInstruction>(
+						std::vector<std::pair<int, int>> { { p, 1 }, { q, 1 },
+								{ r, 0 }, { (p + q + r) % n, 0 } },
+						0.001 * (p + 2 * q + 3 * r)));
+			}
+		}
+	}
+
+	JordanWignerIRTransformation serial, parallel;
+	serial.runParallel = false;
+	auto expected = serial.transform(*kernel);
+
+	xacc::setOption("fermion-transformation-threads", "4");
+	auto result = parallel.transform(*kernel);
+	xacc::unsetOption("fermion-transformation-threads");
+
+	EXPECT_TRUE(expected == result);
+
+	// The same terms in a columnar kernel map to the same operator
+	FermionTermColumns columns;
+	for (auto& inst : kernel->getInstructions()) {
+		columns.insertTerm(columns.nTerms(), inst);
+	}
+	ColumnarFermionKernel columnar("foo", std::move(columns));
+	EXPECT_EQ(kernel->nInstructions(), columnar.nInstructions());
+
+	JordanWignerIRTransformation columnarSerial, columnarParallel;
+	columnarSerial.runParallel = false;
+	EXPECT_TRUE(expected == columnarSerial.transform(columnar));
+
+	xacc::setOption("fermion-transformation-threads", "4");
+	EXPECT_TRUE(expected == columnarParallel.transform(columnar));
+	xacc::unsetOption("fermion-transformation-threads");
+}
+
+TEST(JordanWignerTransformationTester,checkClosedForms) {
+
+	xacc::setOption("n-qubits", "4");
+	std::complex<double> i(0, 1);
+
+	// Hopping, a^dag_0 a_2
+	FermionKernel hopping("hopping");
+	hopping.addInstruction(std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 0, 1 }, { 2, 0 } }, 2.0));
+	PauliOperator expected;
+	expected += PauliOperator({{0,"X"}, {1,"Z"}, {2,"X"}}, 0.5);
+	expected += PauliOperator({{0,"Y"}, {1,"Z"}, {2,"Y"}}, 0.5);
+	expected += PauliOperator({{0,"X"}, {1,"Z"}, {2,"Y"}}, 0.5 * i);
+	expected += PauliOperator({{0,"Y"}, {1,"Z"}, {2,"X"}}, -0.5 * i);
+
+	JordanWignerIRTransformation t;
+	EXPECT_TRUE(expected == t.transform(hopping));
+
+	// Coulomb, a^dag_3 a^dag_1 a_1 a_3 = n_1 n_3,
+	// and exchange, a^dag_3 a^dag_1 a_3 a_1 = -n_1 n_3
+	FermionKernel coulomb("coulomb");
+	coulomb.addInstruction(std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 3, 1 }, { 1, 1 }, { 1, 0 },
+					{ 3, 0 } }, 4.0));
+	coulomb.addInstruction(std::make_shared<FermionInstruction>(
+			std::vector<std::pair<int, int>> { { 3, 1 }, { 1, 1 }, { 3, 0 },
+					{ 1, 0 } }, 2.0));
+	expected = PauliOperator(0.5);
+	expected += PauliOperator({{1,"Z"}}, -0.5);
+	expected += PauliOperator({{3,"Z"}}, -0.5);
+	expected += PauliOperator({{1,"Z"}, {3,"Z"}}, 0.5);
+
+	xacc::setOption("fermion-no-simplify", "");
+	EXPECT_TRUE(expected == t.transform(coulomb));
+	xacc::unsetOption("fermion-no-simplify");
+	EXPECT_TRUE(expected == t.transform(coulomb));
+}
+
 int main(int argc, char** argv) {
    xacc::Initialize(argc,argv);
    ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,171 @@
+/***********************************************************************************
+ * Copyright (c) 2016, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <gtest/gtest.h>
+#include "ParityIRTransformation.hpp"
+#include "TernaryTreeIRTransformation.hpp"
+#include "JordanWignerIRTransformation.hpp"
+#include "XACC.hpp"
+#include <Eigen/Dense>
+#include <sstream>
+
+using namespace xacc::vqe;
+
+const std::string h2 = R"h2(
+    0.7080240949826064
+    -1.248846801817026 0 1 0 0
+    -1.248846801817026 1 1 1 0
+    -0.4796778151607899 2 1 2 0
+    -0.4796778151607899 3 1 3 0
+    0.33667197218932576 0 1 1 1 1 0 0 0
+    0.0908126658307406 0 1 1 1 3 0 2 0
+    0.09081266583074038 0 1 2 1 0 0 2 0
+    0.331213646878486 0 1 2 1 2 0 0 0
+    0.09081266583074038 0 1 3 1 1 0 2 0
+    0.331213646878486 0 1 3 1 3 0 0 0
+    0.33667197218932576 1 1 0 1 0 0 1 0
+    0.0908126658307406 1 1 0 1 2 0 3 0
+    0.09081266583074038 1 1 2 1 0 0 3 0
+    0.331213646878486 1 1 2 1 2 0 1 0
+    0.09081266583074038 1 1 3 1 1 0 3 0
+    0.331213646878486 1 1 3 1 3 0 1 0
+    0.331213646878486 2 1 0 1 0 0 2 0
+    0.09081266583074052 2 1 0 1 2 0 0 0
+    0.331213646878486 2 1 1 1 1 0 2 0
+    0.09081266583074052 2 1 1 1 3 0 0 0
+    0.09081266583074048 2 1 3 1 1 0 0 0
+    0.34814578469185886 2 1 3 1 3 0 2 0
+    0.331213646878486 3 1 0 1 0 0 3 0
+    0.09081266583074052 3 1 0 1 2 0 1 0
+    0.331213646878486 3 1 1 1 1 0 3 0
+    0.09081266583074052 3 1 1 1 3 0 1 0
+    0.09081266583074048 3 1 2 1 0 0 1 0
+    0.34814578469185886 3 1 2 1 2 0 3 0
+)h2";
+
+std::shared_ptr<FermionKernel> h2Kernel() {
+	auto kernel = std::make_shared<FermionKernel>("h2");
+	std::istringstream lines(h2);
+	std::string line;
+	while (std::getline(lines, line)) {
+		std::istringstream ss(line);
+		double coeff;
+		if (!(ss >> coeff)) {
+			continue;
+		}
+		std::vector<std::pair<int, int>> operators;
+		int site, creation;
+		while (ss >> site >> creation) {
+			operators.push_back({ site, creation });
+		}
+		kernel->addInstruction(
+				std::make_shared<FermionInstruction>(operators, coeff));
+	}
+	return kernel;
+}
+
+const double groundStateEnergy(PauliOperator& op) {
+	auto data = op.toDenseMatrix(4).data();
+	Eigen::MatrixXcd A = Eigen::Map<Eigen::MatrixXcd>(data, 16, 16);
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> es(A);
+	return es.eigenvalues()[0];
+}
+
+/**
+ * Checks shared by all encodings given by Majorana operators.
+ */
+template<typename T>
+class MajoranaEncodingTester: public ::testing::Test {
+};
+
+using Encodings = ::testing::Types<ParityIRTransformation, TernaryTreeIRTransformation>;
+TYPED_TEST_CASE(MajoranaEncodingTester, Encodings);
+
+TYPED_TEST(MajoranaEncodingTester,checkMajoranas) {
+
+	// All Majorana operators must pairwise anticommute
+	std::vector<BinaryPauliTerm> c, d;
+	TypeParam::majoranas(9, c, d);
+	std::vector<BinaryPauliTerm> all(c);
+	all.insert(all.end(), d.begin(), d.end());
+	for (int i = 0; i < all.size(); i++) {
+		for (int j = i + 1; j < all.size(); j++) {
+			EXPECT_FALSE(all[i].commutes(all[j]));
+		}
+	}
+}
+
+TYPED_TEST(MajoranaEncodingTester,checkH2Transform) {
+
+	xacc::setOption("n-qubits", "4");
+	auto kernel = h2Kernel();
+
+	JordanWignerIRTransformation jw;
+	TypeParam t;
+	auto jwResult = jw.transform(*kernel);
+	auto result = t.transform(*kernel);
+
+	// All encodings give the same spectrum
+	EXPECT_NEAR(groundStateEnergy(jwResult), groundStateEnergy(result), 1e-8);
+	EXPECT_NEAR(-1.137, groundStateEnergy(result), 1e-3);
+
+	EXPECT_EQ(result.nTerms() - 1, t.getWeightReport().nTerms);
+}
+
+TEST(MajoranaEncodingTester,checkParityWeight) {
+
+	xacc::setOption("n-qubits", "4");
+	auto kernel = h2Kernel();
+
+	ParityIRTransformation t;
+	t.transform(*kernel);
+
+	// Parity strings carry the X update string above each mode
+	EXPECT_EQ(4, t.getWeightReport().maxWeight);
+}
+
+TEST(MajoranaEncodingTester,checkTernaryTreeWeight) {
+
+	// Ternary tree Majoranas have weight at most ceil(log3(2n + 1))
+	std::vector<BinaryPauliTerm> c, d;
+	TernaryTreeIRTransformation::majoranas(40, c, d);
+	for (int i = 0; i < 40; i++) {
+		EXPECT_TRUE(c[i].weight() <= 4);
+		EXPECT_TRUE(d[i].weight() <= 4);
+	}
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc,argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
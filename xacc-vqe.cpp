@@ -10,9 +10,6 @@ int main(int argc, char** argv) {
 	// All our important stuff is in the xacc::vqe namespace
 	using namespace xacc::vqe;
 
-	// Initialize MPI, create a VQEProgram pointer
-	std::shared_ptr<VQEProgram> program;
-
 	// Add some command line options for this XACC app
 	auto vqeOptions = std::make_shared<options_description>("XACC-VQE Options");
 	vqeOptions->add_options()
@@ -52,6 +49,16 @@ int main(int argc, char** argv) {
 		int rank = world->rank();
 		xacc::setGlobalLoggerPredicate( [&]() { return rank == 0;});
 		xacc::info("Using Boost MPI for distributed computations.");
+	} else if (xacc::optionExists("mpi-threads")
+			&& xacc::hasService<MPIProvider>("threads")) {
+		// Ranks are threads, run() below launches them
+		provider = xacc::getService<MPIProvider>("threads");
+		provider->initialize(argc,argv);
+		xacc::setGlobalLoggerPredicate([provider]() {
+			return provider->getCommunicator()->rank() == 0;
+		});
+		xacc::info("Using threads for distributed computations.");
+		xacc::info("Number of Ranks = " + xacc::getOption("mpi-threads"));
 	} else {
 		provider = xacc::getService<MPIProvider>("no-mpi");
 		provider->initialize(argc,argv);
@@ -59,7 +66,9 @@ int main(int argc, char** argv) {
 		xacc::info("XACC-VQE Built without MPI Support.");
 	}
 
-	xacc::info("Number of Ranks = " + std::to_string(world->size()));
+	if (world) {
+		xacc::info("Number of Ranks = " + std::to_string(world->size()));
+	}
 	if (!xacc::optionExists("accelerator")) {
 		xacc::setAccelerator("vqe-dummy");
 		// Set the default Accelerator to TNQVM
@@ -105,29 +114,44 @@ int main(int argc, char** argv) {
 	std::string src((std::istreambuf_iterator<char>(moleculeKernelHpp)),
 			std::istreambuf_iterator<char>());
 
+	std::string spsrc;
 	if (xacc::optionExists("vqe-ansatz")) {
         fileName = xacc::getOption("vqe-ansatz");
         if (!boost::filesystem::exists(fileName)) {
             xacc::error("Error: No such file - " + fileName);
         }
 		std::ifstream spKernelHpp(xacc::getOption("vqe-ansatz"));
-		std::string spsrc((std::istreambuf_iterator<char>(spKernelHpp)),
+		spsrc = std::string((std::istreambuf_iterator<char>(spKernelHpp)),
 				std::istreambuf_iterator<char>());
-		program = std::make_shared<VQEProgram>(accelerator, src, spsrc, world);
-	} else {
-		program = std::make_shared<VQEProgram>(accelerator, src, world);
 	}
 
-	program->build();
+	// Run the VQE program on every rank of this process
+	provider->run([&](std::shared_ptr<Communicator> world) {
+
+		// Every rank builds its own VQEProgram and task
+		std::shared_ptr<VQEProgram> program;
+		if (!spsrc.empty()) {
+			program = std::make_shared<VQEProgram>(accelerator, src, spsrc, world);
+		} else {
+			program = std::make_shared<VQEProgram>(accelerator, src, world);
+		}
+
+		program->build();
+
+		// Thread ranks build one after another, no rank may
+		// read the options while another still builds
+		int built = 1, nBuilt = 0;
+		world->sumInts(built, nBuilt);
+
+		auto buffer = accelerator->createBuffer("q",program->getNQubits());
+		program->setGlobalBuffer(buffer);
 
-    auto buffer = accelerator->createBuffer("q",program->getNQubits());
-    program->setGlobalBuffer(buffer);
-    
-	auto parameters = VQEParameterGenerator::generateParameters(program->getNParameters(), world);
-	auto vqeTask = xacc::getService<VQETask>(task);
-	vqeTask->setVQEProgram(program);
+		auto parameters = VQEParameterGenerator::generateParameters(program->getNParameters(), world);
+		auto vqeTask = xacc::getService<VQETask>(task)->clone();
+		vqeTask->setVQEProgram(program);
 
-	VQETaskResult result = vqeTask->execute(parameters);
+		VQETaskResult result = vqeTask->execute(parameters);
+	});
 
 	//std::string msg = "Energy = ";
 	//for (auto r : result.results) {